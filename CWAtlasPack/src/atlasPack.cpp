@@ -0,0 +1,42 @@
+/*! \file atlasPack.cpp
+\brief Contains the entry point for the offline texture atlas packer (CWAtlasPack).
+* Packs every png in the texture directory into atlas.png, and writes atlas.txt with the rect of each texture within it.
+*/
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include "textureAtlas.h"
+
+int main(int argc, char* argv[]) /** Entry point for the atlas packer */
+{
+	if (argc != 2)
+	{
+		std::cout << "usage: CWAtlasPack <texture directory>" << std::endl;
+		return 1;
+	}
+	std::string directory = std::string(argv[1]) + "/";
+
+	//every png in the directory, other than a previously packed atlas.
+	std::vector<std::string> fileNames;
+	for (const auto& entry : std::filesystem::directory_iterator(directory))
+	{
+		std::string fileName = entry.path().filename().string();
+		if (entry.path().extension() == ".png" && fileName != "atlas.png")
+		{
+			fileNames.push_back(fileName);
+		}
+	}
+	std::sort(fileNames.begin(), fileNames.end());
+
+	//pack and save.
+	TextureAtlas atlas;
+	sf::Image image;
+	if (!atlas.pack(directory, fileNames, image) || !atlas.saveToFile(image, directory, "atlas.png", "atlas.txt"))
+	{
+		return 1;
+	}
+
+	std::cout << "packed " << atlas.getCount() << " textures into " << directory << "atlas.png (" << image.getSize().x << "x" << image.getSize().y << ")" << std::endl;
+	return 0;
+}
@@ -0,0 +1,38 @@
+/*! \file levelCook.cpp
+\brief Contains the entry point for the offline level cooker (CWLevelCook).
+* Parses a text level description and writes the compact binary the game loads at runtime, split into chunks it can stream.
+*/
+
+#include <iostream>
+#include "level.h"
+
+int main(int argc, char* argv[]) /** Entry point for the level cooker */
+{
+	if (argc != 3)
+	{
+		std::cout << "usage: CWLevelCook <level.txt> <level.lvl>" << std::endl;
+		return 1;
+	}
+
+	//parse the text description.
+	LevelData level;
+	if (!level.loadText(argv[1]))
+	{
+		return 1;
+	}
+
+	//split into chunks, then write the cooked binary.
+	level.buildChunks(LevelData::defaultChunkWidth);
+	if (!level.saveCooked(argv[2]))
+	{
+		return 1;
+	}
+
+	//report what was cooked.
+	std::cout << "cooked " << argv[1] << " to " << argv[2] << ": " << level.entities.size() << " objects, " << level.checkpoints.size() << " checkpoints, " << level.chunks.size() << " chunks" << std::endl;
+	for (int kind = 0; kind < LevelEntity::KIND_COUNT; kind++)
+	{
+		std::cout << "  " << LevelData::kindName(kind) << ": " << level.kindCounts[kind] << std::endl;
+	}
+	return 0;
+}
@@ -3,6 +3,12 @@
 \file ObjectContactListener.h
 */
 #include <Box2D/Box2D.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "tracer.h"
+#include "bodyTag.h"
+#include "gameEvent.h"
 #include "dynamicCircle.h"
 #include "dynamicRect.h"
 #include "staticRect.h"
@@ -11,22 +17,74 @@
 #include "item.h"
 #include "enemy.h"
 #include "obstacle.h"
+#include "objectPool.h"
 /*!
 \class ObjectContactListener
 \brief Listener, listening for contacts between objects in world and then implementing desired outcomes of those collisions.
+\ Contacts are dispatched through a table keyed on the BodyTag kinds of both bodies, to one handler per pair of kinds.
+\ What the handlers decide is pushed as GameEvents onto a lock-free queue, which Game drains in one batch after each step.
 */
 
 class ObjectContactListener : public b2ContactListener
 {
+private:
+	//! handler for one pair of kinds, always given the tags in the order the pair was registered in.
+	typedef void (ObjectContactListener::*PairHandler)(BodyTag first, BodyTag second, b2Contact* contact);
+
+	//! entry in a dispatch table, swap is set when the contact's A/B order is the reverse of the registered order.
+	struct PairEntry {
+		PairHandler handler;
+		bool swap;
+	};
+
+	PairEntry beginTable[BodyTag::KIND_COUNT][BodyTag::KIND_COUNT];	//!< handlers for entering a collision, by (kindA, kindB).
+	PairEntry endTable[BodyTag::KIND_COUNT][BodyTag::KIND_COUNT];	//!< handlers for exiting a collision, by (kindA, kindB).
+	std::string pairNames[BodyTag::KIND_COUNT][BodyTag::KIND_COUNT];	//!< "KINDA-KINDB" for each pair, what contact trace events are tagged with.
+
+	ObjectPool<StaticRect>* groundList = nullptr;		//!< pointer to the ground block pool, indexed by GROUND tags.
+	std::vector<Player>* playerList = nullptr;			//!< pointer to the players, indexed by PLAYER tags.
+	ObjectPool<Enemy>* enemyList = nullptr;			//!< pointer to the enemy pool, indexed by ENEMY tags.
+	ObjectPool<Item>* itemList = nullptr;				//!< pointer to the item pool, indexed by ITEM tags.
+	std::vector<BodyTag> removals;						//!< objects stomped or collected during this step, for Game to release after it.
+	ObjectPool<Obstacle>* obstacleList = nullptr;		//!< pointer to the obstacle pool, indexed by OBSTACLE tags.
+	ObjectPool<StaticSensor>* sensorList = nullptr;	//!< pointer to the sensor pool, indexed by SENSOR tags.
+
+	GameEventQueue events;	//!< what happened during the step, in order, the listener is the only producer.
+
+	static const float landingNormal;	//!< how far up a surface's contact normal must point for a player touching it to have landed on top.
+	std::vector<std::pair<b2Contact*, uint16>> groundedContacts;	//!< contacts players are standing on, and which player, so leaving one surface while still on another doesn't unground.
+
+	void raise(GameEvent::Type type, BodyTag subject);	//!< function to push an event for Game.
+
+	void addPair(PairEntry table[BodyTag::KIND_COUNT][BodyTag::KIND_COUNT], BodyTag::Kind first, BodyTag::Kind second, PairHandler handler);	//!< function to register a handler for both orders of a pair.
+	void dispatch(PairEntry table[BodyTag::KIND_COUNT][BodyTag::KIND_COUNT], b2Contact* contact);	//!< function to look up and call the handler for a contact.
+	const char* pairName(b2Contact* contact) const;	//!< function to return the name of the pair of kinds in a contact.
+	bool sensorCheck(b2Contact* contact);	//!< function to call the action of a sensor in the contact, returns true if either fixture is a sensor.
+	bool isOnTop(const b2Body* body, b2Contact* contact) const;	//!< function to check from the contact normal whether a body is on top of the other fixture.
+	void land(BodyTag player, BodyTag surface, b2Contact* contact);	//!< function to ground a player that has landed on a surface.
+	void leave(BodyTag player, BodyTag surface, b2Contact* contact);	//!< function to unground a player leaving the last surface it stood on.
+
+	void beginPlayerGround(BodyTag player, BodyTag ground, b2Contact* contact);		//!< PLAYER enters collision with GROUND.
+	void endPlayerGround(BodyTag player, BodyTag ground, b2Contact* contact);		//!< PLAYER exits collision with GROUND.
+	void beginEnemyObstacle(BodyTag enemy, BodyTag obstacle, b2Contact* contact);	//!< ENEMY enters collision with OBSTACLE.
+	void beginEnemyEnemy(BodyTag enemy1, BodyTag enemy2, b2Contact* contact);		//!< ENEMY enters collision with another ENEMY.
+	void beginPlayerEnemy(BodyTag player, BodyTag enemy, b2Contact* contact);		//!< PLAYER enters collision with ENEMY.
+	void endPlayerEnemy(BodyTag player, BodyTag enemy, b2Contact* contact);			//!< PLAYER exits collision with ENEMY.
+	void beginPlayerItem(BodyTag player, BodyTag item, b2Contact* contact);			//!< PLAYER enters collision with ITEM.
+	void beginPlayerObstacle(BodyTag player, BodyTag obstacle, b2Contact* contact);	//!< PLAYER enters collision with OBSTACLE.
+	void endPlayerObstacle(BodyTag player, BodyTag obstacle, b2Contact* contact);	//!< PLAYER exits collision with OBSTACLE.
 public:
+	ObjectContactListener();	//!< constructor, builds the dispatch tables.
+
+	//! function to give the listener the object lists that the body tags index into.
+	void setObjectLists(ObjectPool<StaticRect>* ground, std::vector<Player>* players, ObjectPool<Enemy>* enemies, ObjectPool<Item>* items, ObjectPool<Obstacle>* obstacles, ObjectPool<StaticSensor>* sensors);
+
 	void BeginContact(b2Contact* contact);	//!< function for entering a collision.
 	void EndContact(b2Contact* contact);	//!< function for exiting a collision.
 
 	void PreSolve(b2Contact* contact);		//!< function to implement actions pre ain contact of collision.
 	void PostSolve(b2Contact* contact);		//!< function to implement actions post main contact of collision.
 
-	void scoreCounter(int& totalScore);		//!< function to pass the playerScore when called.					
-	void isPlayerGrounded(bool& canJump);	//!< function to pass whether player is on ground.
-	void isPlayerDead(bool& isDead);		//!< function to pass whether player is dead.
-	void playAudio(bool& coin, bool& enemy);	//!< function to pass whether certain audios need to be played.
-};
\ No newline at end of file
+	GameEventQueue& getEvents() { return events; }	//!< function to return the events raised, for the one consumer to drain.
+	void collectRemovals(std::vector<BodyTag>& removed);	//!< function to pass the objects to remove after the step.
+};
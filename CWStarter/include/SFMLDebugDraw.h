@@ -1,32 +1,63 @@
 #pragma once
-
+/*!
+\file SFMLDebugDraw.h
+*/
 #include <Box2D/Box2D.h>
 #include <SFML/Graphics.hpp>
+#include <vector>
 
+/*! \class DebugDraw
+\brief Box2D debug drawing into two vertex arrays kept between frames, one of lines and one of triangles.
+\ A frame of debug shapes is two draw calls, and once the arrays have grown no allocation.
+*/
 class DebugDraw : public b2Draw { // b2Draw has all the virtual functions that we need to override here
 private:
-	std::vector<sf::VertexArray> m_shapes; //!< SFML shapes (made from vertexarrays) to be drawn to the screen
+	sf::VertexArray m_lines = sf::VertexArray(sf::Lines);			//!< every outline, segment and axis, two vertices a line.
+	sf::VertexArray m_triangles = sf::VertexArray(sf::Triangles);	//!< every filled shape and point, three vertices a triangle.
+
+	void addLine(const b2Vec2& p1, const b2Vec2& p2, const sf::Color& colour);	//!< function to append one line.
+	void addTriangle(const b2Vec2& p1, const b2Vec2& p2, const b2Vec2& p3, const sf::Color& colour);	//!< function to append one filled triangle.
 public:
+	static const int circleSegments = 16;	//!< lines each circle is drawn with.
+
 	void DrawPoint(const b2Vec2& p, float32 size, const b2Color& color); //!< Draw a point (dot)
 	void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color); //!< Draw a filled polygon
 	void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color); //!< Draw the outline of a polygon
 	void DrawCircle(const b2Vec2& center, float32 radius, const b2Color& color); //!< Draw a circle outline
 	void DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& color); //!< Draw a filled circle with axis
 	void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color); //!< Draw line segment
-	void DrawTransform(const b2Transform& xf); //!< Drawa transform - not implemented
+	void DrawTransform(const b2Transform& xf); //!< Draw a transform, its x axis red and its y axis green
 
-	std::vector<sf::VertexArray> getShapes() const { return m_shapes; }; //!< Return the shapes to be drawn
-	void clearShapes() {m_shapes.clear();}; //!< Clear shape buffer
+	const sf::VertexArray& getLines() const { return m_lines; } //!< Return the lines to be drawn
+	const sf::VertexArray& getTriangles() const { return m_triangles; } //!< Return the triangles to be drawn
+	void clearShapes(); //!< Empty both arrays, keeping their memory
 };
 
-class SFMLDebugDraw : public sf::Drawable 
+/*! \class SFMLDebugDraw
+\brief Draws the Box2D world for debugging, only what overlaps the view, with each layer but the shapes toggled separately.
+\ The fixtures in view are found with a query of the broadphase, so a long level costs no more to debug draw than a short one.
+\ Bodies put to sleep with SetActive(false) have no broadphase proxies, so they aren't drawn.
+*/
+class SFMLDebugDraw : public sf::Drawable
 {
 private:
+	/*! \struct FixtureQuery
+	\brief Collects the fixtures a broadphase query reports, the list kept between frames.
+	*/
+	struct FixtureQuery : public b2QueryCallback {
+		std::vector<b2Fixture*> fixtures;	//!< fixtures reported, a chain once for each of its edges in view.
+		std::vector<b2Body*> bodies;		//!< their bodies, one each.
+		bool ReportFixture(b2Fixture* fixture) { fixtures.push_back(fixture); return true; }	//!< function to collect a fixture and carry on.
+	};
+
 	b2World * m_pWorld = nullptr; //!< Pointer to the Box2D world.  Using pointers as BOX2D has it's own memory management
-	DebugDraw m_debugDraw; //!< Debug draw class
+	mutable DebugDraw m_debugDraw; //!< Debug draw class, rebuilt each draw into arrays that keep their memory
+	mutable FixtureQuery m_query; //!< Fixtures in view, found each draw
+
+	void drawFixture(const b2Fixture* fixture, const b2AABB& bounds) const; //!< Draw one fixture's shape, only the edges of a chain in view
 public:
 	void setWorld(b2World * world); //!< Set the world pointer
-	void draw(sf::RenderTarget &target, sf::RenderStates states) const; //!< Draw debug shapes - overidden from drawable
-	void clear(); //!< Clear shape buffer
+	void draw(sf::RenderTarget &target, sf::RenderStates states) const; //!< Draw debug shapes in the target's view - overidden from drawable
+	void toggleFlag(uint32 flag); //!< Turn a layer on or off, a b2Draw flag
+	uint32 getFlags() const { return m_debugDraw.GetFlags(); } //!< Return the layers drawn, b2Draw flags
 };
-
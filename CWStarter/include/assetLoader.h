@@ -0,0 +1,91 @@
+#pragma once
+/*!
+\file assetLoader.h
+*/
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "assetRegistry.h"
+
+/*! \class AssetLoader
+\brief Loads assets in two halves, decoding them from disk on worker threads then finishing them on the main thread a few at a time.
+\ The decode half must only touch memory of its own, such as an sf::Image or a sample buffer, the finish half does the OpenGL and OpenAL uploads.
+\ Finishing is in the order assets were added, so a later asset can rely on an earlier one being ready.
+\ Assets added with addShared are looked up in the AssetRegistry first, and only decoded and uploaded if no other Game has them loaded.
+*/
+
+class AssetLoader {
+public:
+	typedef std::function<bool()> Decode;		//!< decodes an asset off the main thread, returns whether it loaded.
+	typedef std::function<void(bool)> Finish;	//!< finishes an asset on the main thread, told whether the decode worked so it can use a placeholder if not.
+private:
+	/*! \struct Job
+	\brief One asset, its two halves and the future its decode result arrives through.
+	*/
+	struct Job {
+		std::string name;			//!< what is being loaded, for the log.
+		Decode decode;				//!< decode half.
+		Finish finish;				//!< finish half.
+		std::promise<bool> promise;	//!< set by the worker that decodes it.
+		std::future<bool> result;	//!< read by the main thread once the decode is done.
+	};
+
+	std::vector<std::unique_ptr<Job>> jobs;	//!< every asset added, in finishing order.
+	std::vector<std::thread> workers;		//!< decode threads, joined once they run out of jobs.
+	std::atomic<size_t> nextDecode{ 0 };	//!< next job a worker will take.
+	std::atomic<bool> stopping{ false };	//!< set to make the workers stop taking jobs.
+	size_t nextFinish = 0;					//!< next job the main thread will finish.
+	size_t failures = 0;					//!< how many decodes failed.
+
+	void work();	//!< function run by each worker, decoding jobs until none are left.
+public:
+	~AssetLoader();	//!< deconstructor, stops and joins the workers.
+
+	void add(const std::string& name, Decode decode, Finish finish);	//!< function to add an asset, before start.
+
+	//! Function to add an asset that is shared through the AssetRegistry, loading it only if no other Game already has.
+	/*!
+	\param std::string name - what is being loaded, for the log.
+	\param std::string path - what it is loaded from, the key it is shared under.
+	\param std::function decode - decodes into a new asset, off the main thread.
+	\param std::function upload - finishes the new asset on the main thread, told whether the decode worked.
+	\param std::function use - hands the shared asset, or an unshared placeholder if it didn't load, to the Game.
+	*/
+	template<typename T>
+	void addShared(const std::string& name, const std::string& path, std::function<bool(T&)> decode, std::function<void(T&, bool)> upload, std::function<void(std::shared_ptr<const T>)> use)
+	{
+		std::shared_ptr<T> loading = std::make_shared<T>();
+		std::shared_ptr<std::shared_ptr<const T>> shared = std::make_shared<std::shared_ptr<const T>>();
+		add(name, [path, decode, loading, shared]() {
+			//holding the handle from here keeps the asset alive until it is used.
+			*shared = AssetRegistry::find<T>(path);
+			return *shared ? true : decode(*loading);
+		}, [path, upload, use, loading, shared](bool decoded) {
+			//another Game may have finished the same asset while this one decoded it.
+			if (!*shared)
+			{
+				*shared = AssetRegistry::find<T>(path);
+			}
+			if (!*shared)
+			{
+				//only what loaded is shared, so a later Game tries a missing asset again.
+				upload(*loading, decoded);
+				*shared = decoded ? AssetRegistry::add<T>(path, loading) : loading;
+			}
+			use(*shared);
+		});
+	}
+
+	void start(unsigned threadCount = 2);	//!< function to start decoding on worker threads.
+	void loadNow();		//!< function to decode and finish every asset on the calling thread, for builds with no window.
+	bool finish(int maxJobs);	//!< function to finish up to maxJobs decoded assets, returns whether every asset is finished.
+	void stop();		//!< function to stop the workers after their current job and wait for them.
+
+	bool isFinished() const { return nextFinish == jobs.size(); }	//!< function to return whether every asset is finished.
+	float getProgress() const { return jobs.empty() ? 1.0f : (float)nextFinish / (float)jobs.size(); }	//!< function to return the fraction of assets finished.
+	size_t getFailures() const { return failures; }	//!< function to return how many assets fell back to a placeholder.
+};
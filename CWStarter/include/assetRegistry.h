@@ -0,0 +1,74 @@
+#pragma once
+/*!
+\file assetRegistry.h
+*/
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+
+/*! \class AssetRegistry
+\brief Process wide table of loaded assets, keyed by type and path, so every Game in the process shares one copy of each.
+\ Handles are shared_ptrs to const, the registry only keeps weak ones, so an asset is freed once the last Game using it goes.
+\ Finding and adding are locked, and safe from any thread, what is shared is never changed after it is added.
+*/
+
+class AssetRegistry {
+private:
+	static std::mutex mutex;	//!< guards the table.
+	static std::map<std::string, std::weak_ptr<const void>> assets;	//!< every asset added, keyed by type then path, some may have been freed.
+
+	//! Function to key an asset by its type as well as its path, so a path can be both, say, a font's bytes and a level.
+	/*!
+	\param std::string path - what the asset was loaded from.
+	\return std::string - the key.
+	*/
+	template<typename T>
+	static std::string keyFor(const std::string& path)
+	{
+		return std::string(typeid(T).name()) + ":" + path;
+	}
+
+	static void prune();	//!< function to drop the entries whose assets have been freed, the lock must be held.
+public:
+	//! Function to return the asset loaded from a path, if one is still in use.
+	/*!
+	\param std::string path - what the asset was loaded from.
+	\return std::shared_ptr - the asset, or empty if it isn't loaded.
+	*/
+	template<typename T>
+	static std::shared_ptr<const T> find(const std::string& path)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto entry = assets.find(keyFor<T>(path));
+		if (entry == assets.end())
+		{
+			return std::shared_ptr<const T>();
+		}
+		return std::static_pointer_cast<const T>(entry->second.lock());
+	}
+
+	//! Function to share a newly loaded asset, unless another thread added the same one first, in which case that one is used.
+	/*!
+	\param std::string path - what the asset was loaded from.
+	\param std::shared_ptr asset - the asset, which must not be changed from here on.
+	\return std::shared_ptr - the asset everyone is sharing, the one given or the one added first.
+	*/
+	template<typename T>
+	static std::shared_ptr<const T> add(const std::string& path, std::shared_ptr<const T> asset)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		prune();
+		std::weak_ptr<const void>& entry = assets[keyFor<T>(path)];
+		std::shared_ptr<const void> existing = entry.lock();
+		if (existing)
+		{
+			return std::static_pointer_cast<const T>(existing);
+		}
+		entry = asset;
+		return asset;
+	}
+
+	static size_t getCount();	//!< function to return how many assets are loaded and in use.
+};
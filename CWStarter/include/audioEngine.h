@@ -0,0 +1,105 @@
+#pragma once
+/*!
+\file audioEngine.h
+*/
+#include <cstdint>
+#include <memory>
+#ifndef HEADLESS
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "spscQueue.h"
+#else
+#include "headlessAudio.h"
+#endif
+
+#ifndef HEADLESS
+/*! \class AudioEngine
+\brief Plays the sound effects on a thread of its own, from a fixed pool of voices, so overlapping effects each get a voice and no OpenAL call is made in the frame.
+\ The game thread only pushes small commands onto a lock-free queue, the audio thread owns the voices and is the only one to touch them.
+\ When every voice is busy a new effect takes the voice of the lowest priority effect no higher than its own, the oldest first, or is dropped.
+*/
+
+class AudioEngine {
+public:
+	//! the sound effects.
+	enum Sound : uint8_t {
+		JUMP,
+		HIT,
+		DEAD,
+		PICK_UP,
+		SOUND_COUNT
+	};
+	static const int voiceCount = 8;	//!< most effects playing at once.
+private:
+	/*! \struct Command
+	\brief One request from the game thread.
+	*/
+	struct Command {
+		//! what to do.
+		enum Type : uint8_t {
+			SET_BUFFER,	//!< give a sound its buffer and priority.
+			PLAY		//!< play a sound.
+		};
+		Type type;							//!< what to do.
+		uint8_t sound;						//!< which sound.
+		uint8_t priority;					//!< priority, for SET_BUFFER.
+		const sf::SoundBuffer* buffer;		//!< buffer, for SET_BUFFER, kept alive by the game thread's handle.
+	};
+
+	/*! \struct Voice
+	\brief One of the pool's sf::Sounds and what it is playing.
+	*/
+	struct Voice {
+		sf::Sound sound;		//!< the voice.
+		uint8_t priority = 0;	//!< priority of what it last played.
+		uint32_t started = 0;	//!< when it last started, in plays, to find the oldest.
+	};
+
+	//game thread only.
+	std::shared_ptr<const sf::SoundBuffer> buffers[SOUND_COUNT];	//!< each sound's buffer, held so it outlives the voices playing it.
+	std::vector<std::shared_ptr<const sf::SoundBuffer>> retired;	//!< buffers replaced by setSound, held as a voice may still be playing them.
+	SpscQueue<Command, 256> commands;	//!< requests from the game thread to the audio thread.
+
+	//audio thread only.
+	const sf::SoundBuffer* soundBuffers[SOUND_COUNT] = {};	//!< each sound's buffer, as the audio thread has been told.
+	uint8_t soundPriorities[SOUND_COUNT] = {};			//!< each sound's priority, as the audio thread has been told.
+	Voice voices[voiceCount];	//!< the pool, declared after buffers so the voices go first.
+	uint32_t plays = 0;			//!< effects started so far.
+
+	std::atomic<bool> running{ true };	//!< cleared to stop the audio thread.
+	std::thread thread;					//!< the audio thread.
+	static std::mutex attachMutex;		//!< guards attaching voices to buffers, which other Games' audio threads may share.
+
+	void run();	//!< function run by the audio thread, carrying out commands until stopped.
+	void startSound(uint8_t sound);	//!< function to start a sound on a free or stolen voice.
+	Voice* findVoice(uint8_t priority);	//!< function to find a free voice, or the one to steal for an effect of this priority.
+public:
+	AudioEngine();	//!< constructor, starts the audio thread.
+	~AudioEngine();	//!< deconstructor, stops the audio thread and detaches the voices.
+
+	void setSound(Sound sound, std::shared_ptr<const sf::SoundBuffer> buffer, uint8_t priority);	//!< function to give a sound its buffer and priority.
+	void play(Sound sound);	//!< function to ask for a sound to be played, returns straight away.
+};
+#else
+/*! \class AudioEngine
+\brief Headless stand-in, plays nothing and starts no thread.
+*/
+
+class AudioEngine {
+public:
+	//! the sound effects.
+	enum Sound : uint8_t {
+		JUMP,
+		HIT,
+		DEAD,
+		PICK_UP,
+		SOUND_COUNT
+	};
+
+	void setSound(Sound, std::shared_ptr<const sf::SoundBuffer>, uint8_t) {}	//!< no buffer is needed.
+	void play(Sound) {}	//!< no-op.
+};
+#endif
@@ -0,0 +1,80 @@
+#pragma once
+/*!
+\file bodyTag.h
+*/
+#include <Box2D/Box2D.h>
+#include <cstdint>
+/*! \struct BodyTag
+\brief Compact handle stored straight into a body's (or fixture's) user data by value, no allocation needed.
+\ Holds the kind of object the body belongs to and its index in the matching object list in Game.
+*/
+
+struct BodyTag {
+	//! kinds of objects the contact listener can tell apart, NONE is what untagged user data decodes to.
+	enum Kind {
+		NONE = 0,
+		GROUND,
+		PLAYER,
+		ENEMY,
+		ITEM,
+		OBSTACLE,
+		SENSOR,
+		KIND_COUNT
+	};
+
+	uint8 kind;		//!< what kind of object this is, one of Kind.
+	uint16 index;	//!< index of the object within its object list.
+
+	//! Function to pack the tag into a user data pointer.
+	/*!
+	\return void* - kind in bits 16-23 and index in bits 0-15, no memory is pointed at.
+	*/
+	void* toUserData() const
+	{
+		return reinterpret_cast<void*>((static_cast<uintptr_t>(kind) << 16) | index);
+	}
+
+	//! Function to unpack a tag from a user data pointer.
+	/*!
+	\param void* data - user data previously set with toUserData(), or small integer tags that decode to NONE.
+	\return BodyTag - the decoded tag.
+	*/
+	static BodyTag fromUserData(void* data)
+	{
+		uintptr_t bits = reinterpret_cast<uintptr_t>(data);
+		BodyTag tag;
+		tag.kind = static_cast<uint8>((bits >> 16) & 0xFF);
+		tag.index = static_cast<uint16>(bits & 0xFFFF);
+		if (tag.kind >= KIND_COUNT)
+		{
+			tag.kind = NONE;
+		}
+		return tag;
+	}
+
+	//! Function to get the name of a kind, for traces and messages.
+	/*!
+	\param uint8 kind - one of Kind.
+	\return const char* - the kind's name, a string literal.
+	*/
+	static const char* kindName(uint8 kind)
+	{
+		static const char* names[KIND_COUNT] = { "NONE", "GROUND", "PLAYER", "ENEMY", "ITEM", "OBSTACLE", "SENSOR" };
+		return kind < KIND_COUNT ? names[kind] : names[NONE];
+	}
+
+	//! Function to get the tag for a fixture, the fixture's own tag if it has one, otherwise its body's tag.
+	/*!
+	\param b2Fixture fixture - the fixture in contact.
+	\return BodyTag - the tag of the object the fixture belongs to.
+	*/
+	static BodyTag fromFixture(const b2Fixture* fixture)
+	{
+		BodyTag tag = fromUserData(fixture->GetUserData());
+		if (tag.kind == NONE)
+		{
+			tag = fromUserData(fixture->GetBody()->GetUserData());
+		}
+		return tag;
+	}
+};
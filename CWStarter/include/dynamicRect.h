@@ -12,6 +12,6 @@ class DynamicRect : public sf::RectangleShape, public PhysicalObject {
 public:
 	DynamicRect() {};	//!< default constructor.
 	~DynamicRect() {};	//!< default deconstructor.
-	DynamicRect(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture);		//!< complete constructor.
+	DynamicRect(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture);		//!< complete constructor.
 	void update();		//!< function to update the rendering information for these objects.
 };
\ No newline at end of file
@@ -4,34 +4,54 @@
 */
 #include <Box2D/Box2D.h>
 #include <SFML/Graphics.hpp>
+#ifndef HEADLESS
 #include <SFML/Audio.hpp>
+#else
+#include "headlessAudio.h"
+#endif
+#include <deque>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <vector>
 
 #include "SFMLDebugDraw.h"
+#include "assetLoader.h"
+#include "audioEngine.h"
+#include "hudText.h"
+#include "spriteBatch.h"
+#include "textureAtlas.h"
+#include "spatialIndex.h"
+#include "objectPool.h"
+#include "transformStore.h"
+#include "profiler.h"
 #include "dynamicCircle.h"
 #include "dynamicRect.h"
 #include "staticRect.h"
+#include "staticGeometry.h"
 #include "staticSensor.h"
 #include "player.h"
 #include "item.h"
 #include "enemy.h"
 #include "obstacle.h"
 #include "ObjectContactListener.h"
+#include "level.h"
+#include "levelGenerator.h"
+#include "levelStream.h"
 
 /*! \class Game
 \brief All the info about the game; all the objects, rendering and updating the world.
 */
 
 class Game : public sf::Drawable {
+	friend struct BenchAccess;	//!< lets the microbenchmarks in CWStarterBench reach the world and private stages.
 private:
 	sf::View view;			//!<  this view maps from the physical co-ords to the rendering co-ords.
 	sf::Vector2f worldSize = sf::Vector2f(12.0f, 8.0f);		//!< size of this world is 10 by 6 metres.
 	sf::Event keyEvent;		//!< to take the Event of a user/key interaction.
 
-	ObjectContactListener ocl;			//!< reference to class ObjectContactListener.
 	Player pc;							//!< reference to class Player.
-	ObjectContactListener listener;		//<! object for the in world listening object, for object collisions.
+	ObjectContactListener listener;		//!< object for the in world listening object, for object collisions, and the score and player state it keeps.
 	
 	b2World* world = nullptr;			//!< pointer the Box2D world.
 	const int velocityIterations = 7;	//!< each update 7 velocity iterations/corrections within the physics engine.
@@ -39,20 +59,62 @@ private:
 	const b2Vec2 gravity = b2Vec2(0.0f, 9.81f);		//!< standard earth gravity to be used in world. (REMEMBER TO DEDUCT THIS VALUE)
 
 	bool debug = false;			//!< toggle for debug drawing.
-	SFMLDebugDraw debugDraw;	//!< Box2D debug drawing.
+	SFMLDebugDraw debugDraw;	//!< Box2D debug drawing, of what the camera sees, with AABBs, contacts, centres of mass and joints toggled by F3 to F6.
+	mutable SpriteBatch spriteBatch;	//!< batches the players, items and awake enemies by texture, rebuilt each draw.
+#ifdef PROFILING
+	mutable FrameProfiler profiler;	//!< per stage timings of the last few seconds of frames.
+	bool showProfile = false;	//!< whether the profile overlay is drawn, toggled with F1.
+#endif
 
-	sf::Clock marioClock;		//!< clock to track the time of animations.
-	float elapsedTime;			//!< float to take elapsed time between animations.
+	SpatialIndex staticIndex;			//!< grid along x of the items of the chunks built into the world, the blocks and obstacles are culled a chunk at a time.
+	std::vector<BodyTag> visibleObjects;	//!< items overlapping the camera, found each step.
+	float visibleLeft;					//!< left edge of the culling area.
+	float visibleRight;					//!< right edge of the culling area.
+	const float cullMargin = 2.0f;		//!< how far either side of the camera objects still count as visible.
+	const float indexCellWidth = 4.0f;	//!< width of each cell in the spatial index.
+
+	std::vector<uint16> enemyWakeOrder;	//!< enemy indices sorted by spawn x, the awake enemies are a window of it.
+	size_t firstAwakeEnemy = 0;			//!< start of the awake window in enemyWakeOrder.
+	size_t endAwakeEnemy = 0;			//!< one past the end of the awake window in enemyWakeOrder.
+	const float enemyWakeDistance = 10.0f;	//!< enemies ahead of the camera centre wake within this distance.
+	const float enemySleepDistance = 16.0f;	//!< enemies behind the camera centre go to sleep beyond this distance.
+
+	TransformStore transforms;		//!< render transforms of the players, then the enemies in wake order, so the awake ones are one contiguous range.
+	size_t firstEnemyTransform = 0;	//!< index of the first enemy in transforms.
+
+	float elapsedTime;			//!< float to take simulated time elapsed since the last animation frame.
 	sf::IntRect lookRight;		//!< IntRect for spritesheet, used to flip mario to look Right.
 	sf::IntRect lookLeft;		//!< IntRect for spritesheet, used to flip mario to look Left.
 	sf::IntRect lookIdle;		//!< IntRect for spritesheet, used to to keep mario looking in the last direction he moved when idle.
 
-	std::vector<StaticRect> staticBlock;		//!< static rectangles for ground blocks.
-	std::vector<Obstacle> obstaclesList;		//!< static rects for in game obstacles.
-	std::vector<Player> playerObject;			//!< dynamic rectangle for player object.
-	std::vector<Enemy> enemyObject;				//!< dynamic rectangle for the enemy objects.
-	std::vector<StaticSensor> staticSensors;	//!< for the in world static sensors.
-	std::vector<Item> itemList;					//!< list for items in the world.
+	ObjectPool<StaticRect> staticBlock;		//!< pool of static rectangles for ground blocks, released when their chunk is torn down.
+	ObjectPool<Obstacle> obstaclesList;		//!< pool of static rects for in game obstacles.
+	std::vector<Player> playerObject;			//!< dynamic rectangle for player object, never streamed.
+	ObjectPool<Enemy> enemyObject;				//!< pool of dynamic rectangles for the enemy objects, stomped ones are deactivated until respawned.
+	ObjectPool<StaticSensor> staticSensors;	//!< pool for the in world static sensors.
+	ObjectPool<Item> itemList;					//!< pool for items in the world, collected ones are deactivated until their chunk is torn down.
+	std::vector<BodyTag> removedObjects;		//!< objects the contact listener removed in the last step.
+
+	/*! \struct ResidentChunk
+	\brief A chunk of the level built into the world, and the objects it made so they can be taken out again.
+	*/
+	struct ResidentChunk {
+		int index = 0;					//!< which chunk.
+		std::vector<BodyTag> objects;	//!< every object built from the chunk.
+		std::vector<uint32_t> entities;	//!< the level entity each object was built from.
+		StaticGeometry geometry;		//!< the collision of its ground blocks and obstacles, merged.
+		SpriteBatch ground;				//!< its ground blocks, baked into vertices by texture when it is built and never rebuilt.
+		SpriteBatch obstacles;			//!< its obstacles, baked the same way, drawn over the enemies.
+		float left = std::numeric_limits<float>::max();		//!< left edge of what it bakes, to cull it to the camera.
+		float right = std::numeric_limits<float>::lowest();	//!< right edge of what it bakes.
+	};
+	LevelStream levelStream;				//!< reads chunks ahead of the camera, on a thread of its own unless headless.
+	std::deque<ResidentChunk> residentChunks;	//!< the chunks built into the world, a contiguous run in order along x.
+	std::vector<bool> collectedItems;		//!< which level entities are coins already collected, so they stay gone when their chunk is built again.
+	const float chunkBuildAhead = 20.0f;	//!< chunks within this distance ahead of the camera centre are built, further than enemies wake.
+	const float chunkBuildBehind = 20.0f;	//!< chunks within this distance behind are built, further than enemies sleep.
+	const float chunkKeepDistance = 36.0f;	//!< built chunks are torn down once beyond this distance either side, further than they are built so they don't flicker.
+	const float chunkReadAhead = 52.0f;		//!< chunks within this distance ahead are read in the background, so they are ready before they are built.
 
 	b2Body* playerBody;		//!< pointer to the body element of player object; that we'll apply forces to.
 	b2Body* goombaBody;		//!< pointer to the body element of an enemy objec; that we'll apply forces to.
@@ -68,10 +130,7 @@ private:
 
 	b2Vec2 startPosition;	//!< vec2 to hold co-ords for start position in scene. 
 	b2Vec2 currentCheckpoint;	//!< vec2 to contain co-ords location of current checkpoint to respawn.
-	float checkpoint1;		//!< float for x-axis position of checkpoint 1.
-	float checkpoint2;		//!< float for x-axis position of checkpoint 2.
-	float checkpoint3;		//!< float for x-axis position of checkpoint 3.
-	float checkpoint4;		//!< float for x-axis position of checkpoint 4.
+	std::vector<float> checkpoints;	//!< x-axis positions of the checkpoints, in increasing order.
 	float endPosition;		//!< float to hold value for x-axis of end position in scene.
 
 	b2Vec2 playerVelocity;	//!< to hold the current velocity of player.
@@ -79,11 +138,31 @@ private:
 	float velocityChange;	//!< change of velocity required.
 	float impulse;			//!< strength of impulse to be applied as a force on a body.
 
-	void initTexture();		//!< function to initialise all the required textures.
-	void initFontsTexts();	//!< function to initialise all required for fonts/text.
-	void initAudio();		//!< function to initialise all the audio files required.
+	void initTexture();		//!< function to queue the texture atlas to load.
+	void initTextureRects();	//!< function to look up each texture's rect once the atlas has loaded.
+	void initFontsTexts();	//!< function to initialise all required for fonts/text, queueing the font to load.
+	void initAudio();		//!< function to queue all the audio files required to load.
+#ifndef HEADLESS
+	void addSound(const std::string& name, const std::string& fileName, AudioEngine::Sound sound, uint8_t priority);	//!< function to queue a sound clip to load, or share, for the audio engine to play.
+#endif
+	static bool readFile(const std::string& fileName, std::vector<char>& data);	//!< function to read a whole file into memory.
 	void initValues();		//!< function to initialise all necessary vars.
-	void populateWorld();	//!< function to populate the world with all required objects.
+	void populateWorld(const std::string& levelName);	//!< function to queue the level to load then populate the world, from a level file or generated.
+	void startLevel();		//!< function to tag the bodies, set the listener and start the music once the world is built.
+	void buildWorld(const LevelData& level);	//!< function to create the players and the chunks of the level around them.
+	BodyTag addObject(const LevelEntity& entity);	//!< function to create one level object in the world, in its pool, returning its tag.
+	void removeObject(BodyTag tag);	//!< function to destroy one level object's body and release it to its pool.
+	void streamChunks();	//!< function to build chunks the camera nears and tear down those it leaves behind.
+	void buildChunk(int index, bool atFront);	//!< function to build a chunk into the world, at one end of the resident run.
+	void tearDownChunk(ResidentChunk& chunk);	//!< function to take every object a chunk built out of the world.
+	void orderEnemies();	//!< function to rebuild the enemy wake order and transforms after chunks come or go.
+	std::shared_ptr<const LevelData> levelData;	//!< the level being played, kept so other Games playing it share it.
+	sf::IntRect levelTextureRect(uint8 texture);	//!< function to return the atlas rect for a LevelEntity texture id.
+	float cameraCentreX() const;	//!< function to return where the camera is centred on x, from the player body.
+	void cullToView();		//!< function to find the camera's edges and the items overlapping it, the only ones drawn.
+	void releaseRemoved();	//!< function to take objects removed during the step out of the world and back to their pools.
+	void respawnEnemies();	//!< function to bring stomped enemies back, reusing their pool slots.
+	void updateEnemyActivation();	//!< function to wake enemies the camera nears and put those it leaves behind to sleep.
 	void animatePlayer();	//!< function to animate the player object with its spritesheet.
 	void cameraController();//!< function to control the position and boundaries for the camera/view of world.
 	void muteMusic();		//!< function to mute/unmute music.
@@ -97,69 +176,96 @@ private:
 	int lives;				//!< int to take the number of lives.
 	float currentTime;		//!< float to take the time for a time counter.
 	float totalTime;		//!< float to take value of the total time.
-	sf::Clock timerClock;	//!< clock to be used in UI timer.
-	float uiElapsedTime;	//!< float to take the value for elapsed time.
+	float uiElapsedTime;	//!< float to take the simulated time elapsed since the level started, used by the UI timer.
 
 	sf::View uiView;		//!< view to be used to draw/display UI text.
-	sf::Font uiFont;		//!< font to take the font file for the UI text.
-	sf::Text scoreText;		//!< text to take the text information for the UI.
-	sf::Text timerText;		//!< text to take text info for a game timer.
-	sf::Text livesText;		//!< text to take the info for the number of lives the player has.
+	/*! \struct FontAsset
+	\brief A font and the file it is opened from, which SFML reads glyphs from for as long as the font is used.
+	*/
+	struct FontAsset {
+		std::vector<char> data;	//!< the font file.
+		sf::Font font;			//!< the font, opened from data.
+	};
+	std::shared_ptr<const FontAsset> uiFont;	//!< shared font for the UI text, set once loaded.
+	sf::RectangleShape loadingBar;	//!< back of the loading bar, drawn until everything has loaded.
+	sf::RectangleShape loadingFill;	//!< filled part of the loading bar.
+	HudText scoreText;		//!< text to take the text information for the UI.
+	HudText timerText;		//!< text to take text info for a game timer.
+	HudText livesText;		//!< text to take the info for the number of lives the player has.
 	sf::Text tutorialText;	//!< text to take info for the tutorial.
 	sf::Text victoryText1;	//!< text to take victory message text.
 	sf::Text victoryText2;	//!< text to take victory message text.
 	sf::Text gameOverText;	//!< text to take game over message text.
 
 	sf::RectangleShape bgPicture; //!< rectangle shape to hold the background image.
-	sf::Texture background;	//!< texture for background image.
-	sf::Texture brick1x1;	//!< texture for brick 1x1.
-	sf::Texture brick2x1;	//!< texture for brick 2x1.
-	sf::Texture brick3x1;	//!< texture for brick 3x1.
-	sf::Texture brick4x1;	//!< texture for brick 4x1.
-	sf::Texture solidBlock;	//!< texture for solid block.
-	sf::Texture stones;		//!< texture for stones.
-	sf::Texture coin;		//!< texture for coins.
-	sf::Texture smallTube;	//!< texture for small tube.
-	sf::Texture bigTube;	//!< texture for big tube.
-	sf::Texture flag;		//!< texture for the victory flag.
+	const float bgLeft = -6.0f;		//!< x co-ord of the background image's left edge.
+	const float bgWidth = 140.0f;	//!< width of the background image, it is repeated every bgWidth along levels longer than it.
+	std::shared_ptr<const TextureAtlas> atlas;	//!< every texture packed into one image, so the world draws from a single texture, shared by every Game.
+	sf::IntRect background;	//!< atlas rect for background image.
+	sf::IntRect brick1x1;	//!< atlas rect for brick 1x1.
+	sf::IntRect brick2x1;	//!< atlas rect for brick 2x1.
+	sf::IntRect brick3x1;	//!< atlas rect for brick 3x1.
+	sf::IntRect brick4x1;	//!< atlas rect for brick 4x1.
+	sf::IntRect solidBlock;	//!< atlas rect for solid block.
+	sf::IntRect stones;		//!< atlas rect for stones.
+	sf::IntRect coin;		//!< atlas rect for coins.
+	sf::IntRect smallTube;	//!< atlas rect for small tube.
+	sf::IntRect bigTube;	//!< atlas rect for big tube.
+	sf::IntRect flag;		//!< atlas rect for the victory flag.
 
 	sf::Sprite goombaSprite;	//!< sprite to take mushroom walking spritesheet.
-	sf::Texture goombaWalkingSpriteSheet;	//!< texture for mushroom walking spritesheet.
-	sf::Texture goombaDead;	//!< texture for mushroom dead.
+	sf::IntRect goombaWalkingSpriteSheet;	//!< atlas rect for mushroom walking spritesheet.
+	sf::IntRect goombaDead;	//!< atlas rect for mushroom dead.
 
 	sf::Sprite marioSprite;	//!< sprite for mario walking spritesheet.
-	sf::Texture marioIdle;	//!< texture for idle mario.
-	sf::Texture marioWalkingSpritesheet;	//!< texture of mario walking spritesheet.
-	sf::Texture marioDeadSpritesheet;		//!< texture of mario dead spritesheet.
-	sf::Texture marioJumpingSpritesheet;	//!< texture of mario jumping spritesheet.
+	sf::IntRect marioIdle;	//!< atlas rect for idle mario.
+	sf::IntRect marioWalkingSpritesheet;	//!< atlas rect of mario walking spritesheet.
 
 	sf::Music mainMarioMusic;			//!< contains main mario music.
-	sf::SoundBuffer marioJumpBuffer;	//!< contains audio data for mario jump.
-	sf::SoundBuffer marioHitBuffer;		//!< contains audio data for mario hit.
-	sf::SoundBuffer marioDeadBuffer;	//!< contains audio data for mario death.
-	sf::SoundBuffer pickUpBuffer;		//!< contains audio data for item pick up.
-	sf::Sound marioJumpSFX;				//!< sound reference for jump.
-	sf::Sound marioHitSFX;				//!< sound reference for hit.
-	sf::Sound marioDeadSFX;				//!< sound reference for death.
-	sf::Sound pickUpSFX;				//!< sound reference for pick up.
+	AudioEngine audio;					//!< plays the jump, hit, death and pick up SFX on its own thread, from a pool of voices.
 
+	std::shared_ptr<const std::vector<char>> musicData;	//!< the music file, streamed from memory so it is read off the main thread, shared by every Game.
+	bool musicLoaded = false;		//!< bool as to whether the music track loaded.
 	bool musicPlaying;				//!< bool as to whether the music is playing.
-	bool playCoinSFX;				//!< bool as to whether coin SFX needs to be played.
-	bool playHurtSFX;				//!< bool as to whether enemy hurt SFX needs to be played.
 	void playerMovement();			//!< function to apply forces to player body for movement.
 	void playerJump();				//!< function to apply impulse to the y-axis of the player body.
 	void fallenOffScreenCheck();	//!< function to check whether the player has fallen out of the scene.
 	void playerDead();				//!< function for player death, applies required changes to world.
 	void updateUI();				//!< function to update the UI text elements; score, time, lives etc.
 
+	std::vector<GameEvent> eventBatch = std::vector<GameEvent>(64);	//!< events taken off the listener's queue at once, sized up front.
+	const int coinScore = 10;		//!< score for collecting a coin.
+	const int stompScore = 100;		//!< score for stomping an enemy.
+	void handleEvent(const GameEvent& event);	//!< function to act on one event from the contact listener.
+
+#ifndef HEADLESS
+	/*! \struct DecodedSound
+	\brief A sound clip decoded to samples, off the main thread, waiting to go in its buffer.
+	*/
+	struct DecodedSound {
+		std::vector<sf::Int16> samples;	//!< the clip's samples, channels interleaved.
+		unsigned int channelCount = 0;	//!< number of channels.
+		unsigned int sampleRate = 0;	//!< samples per second.
+	};
+#endif
+	const int uploadsPerFrame = 2;	//!< most loaded assets finished each frame, so no frame stalls on the uploads.
+	AssetLoader loader;		//!< loads the textures, font, audio and level in the background, declared after all it loads into so its workers stop first.
+
 public:
-	Game();		//!< constructor to setup the game.
+	Game(const std::string& levelName = "");		//!< constructor to setup the game, on world 1-1 or the level named.
 	~Game();	//!< deconstructor to delete and clean up pointers.
 
-	void update(float timestep);	//!< update the game with the given timestep.
+	bool isLoading() const { return !loader.isFinished(); }	//!< function to return whether assets are still loading, and the game can't yet be updated.
+	bool finishLoading();			//!< function to finish a few more loaded assets, call once per frame while loading.
+	void update(float timestep);	//!< update the game with the given fixed timestep.
+	void interpolate(float alpha);	//!< update rendering positions between the last two physics steps.
+	void endFrame();	//!< close off this frame's profile, call once per rendered frame.
 	void draw(sf::RenderTarget &target, sf::RenderStates states) const;	//!< draw the game to the render context.
 	void toggleDebug();				//!< toggles debug drawing.
 	void userInput(sf::Keyboard::Key key);		//!< user keyboard input to control player object movement.
 	void stopMovement(sf::Keyboard::Key key);	//!< function to stop forces applied to player body.
+	int getScore() const { return score; }		//!< function to return the current player score.
+	int getLives() const { return lives; }		//!< function to return the number of lives left.
+	bool isLevelComplete() const { return levelComplete; }	//!< function to return whether the player has reached the end.
 	bool gameOver;					//!< bool for whether the gameOver parameters have been met.
 };
\ No newline at end of file
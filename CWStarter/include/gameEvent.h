@@ -0,0 +1,29 @@
+#pragma once
+/*!
+\file gameEvent.h
+*/
+#include <cstdint>
+#include "bodyTag.h"
+#include "spscQueue.h"
+/*! \struct GameEvent
+\brief Something that happened in the world during a step, pushed by the contact listener for Game, and anything else listening, to act on.
+\ Small and trivially copyable, so a queue of them is a flat array.
+*/
+
+struct GameEvent {
+	//! what happened.
+	enum Type : uint8_t {
+		COIN_COLLECTED,		//!< the player touched a coin, subject is the coin.
+		ENEMY_STOMPED,		//!< the player landed on an enemy, subject is the enemy.
+		PLAYER_HIT,			//!< an enemy hit the player from the side, subject is the enemy.
+		PLAYER_HIT_ENDED,	//!< the player and the enemy that hit it parted, subject is the enemy.
+		GROUNDED,			//!< the player landed on ground or an obstacle, subject is what it landed on.
+		UNGROUNDED			//!< the player left the top of ground or an obstacle, subject is what it left.
+	};
+
+	Type type;			//!< what happened.
+	BodyTag subject;	//!< the other object involved, the player is always the first.
+};
+
+static const size_t gameEventQueueSize = 4096;	//!< events one step can raise before any are dropped, far more than the player's contacts can.
+typedef SpscQueue<GameEvent, gameEventQueueSize> GameEventQueue;	//!< queue the contact listener pushes a step's events into.
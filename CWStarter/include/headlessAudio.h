@@ -0,0 +1,42 @@
+#pragma once
+/*!
+\file headlessAudio.h
+*/
+#include <SFML/System.hpp>
+#include <string>
+/*!
+\brief Stand-ins for the SFML audio classes used by the game, only included in the HEADLESS build.
+\ They let the simulation run on machines with no sound card and without linking sfml-audio or OpenAL.
+*/
+
+namespace sf {
+	/*! \class SoundBuffer
+	\brief Headless stand-in, loads nothing.
+	*/
+	class SoundBuffer {
+	public:
+		bool loadFromFile(const std::string&) { return true; }	//!< pretends to load the sound file.
+	};
+
+	/*! \class Sound
+	\brief Headless stand-in, plays nothing.
+	*/
+	class Sound {
+	public:
+		void setBuffer(const SoundBuffer&) {}	//!< no buffer is needed.
+		void play() {}		//!< no-op.
+		void pause() {}		//!< no-op.
+		void stop() {}		//!< no-op.
+	};
+
+	/*! \class Music
+	\brief Headless stand-in, streams nothing.
+	*/
+	class Music {
+	public:
+		bool openFromFile(const std::string&) { return true; }	//!< pretends to open the music file.
+		void play() {}		//!< no-op.
+		void pause() {}		//!< no-op.
+		void stop() {}		//!< no-op.
+	};
+}
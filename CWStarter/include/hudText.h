@@ -0,0 +1,26 @@
+#pragma once
+/*!
+\file hudText.h
+*/
+#include <SFML/Graphics.hpp>
+/*! \class HudText
+\brief A text showing a label and a number, such as "Score: 120", which only touches its string when what it shows changes.
+\ The number is formatted into a fixed buffer, so an update that changes nothing costs one comparison and allocates nothing.
+*/
+
+class HudText : public sf::Text {
+private:
+	const char* label = "";			//!< text shown before the number, a string literal.
+	const char* message = nullptr;	//!< text shown in place of the number, a string literal, or nullptr to show the number.
+	int value = 0;					//!< number shown.
+	bool shown = false;				//!< whether the string has been set since the label changed.
+	char buffer[64];				//!< what is shown, formatted in place.
+	int rebuilds = 0;				//!< times the string has been set, so its glyphs rebuilt.
+
+	void show();	//!< function to format the label and number or message into the buffer and set it as the string.
+public:
+	void setLabel(const char* newLabel);	//!< function to set the text shown before the number.
+	void setValue(int newValue);			//!< function to show a number, if it isn't already.
+	void setMessage(const char* newMessage);	//!< function to show a message after the label in place of the number, if it isn't already.
+	int getRebuilds() const { return rebuilds; }	//!< function to return how many times the string has been set.
+};
@@ -0,0 +1,69 @@
+#pragma once
+/*!
+\file inputRecording.h
+*/
+#include <SFML/Window.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Game;
+
+/*! \struct InputEvent
+\brief One key press or release, and the physics step it was applied before.
+*/
+
+struct InputEvent {
+	uint32_t step;	//!< number of physics steps taken before this input was applied.
+	uint8_t key;	//!< the sf::Keyboard::Key, all fit in 7 bits.
+	bool pressed;	//!< true for a press, false for a release.
+};
+
+/*! \struct ReplayOutcome
+\brief How a session ended, stored with its recording so a replay can be checked against it.
+*/
+
+struct ReplayOutcome {
+	int32_t score = 0;				//!< final score.
+	int32_t lives = 0;				//!< lives left at the end.
+	int32_t completionStep = -1;	//!< physics steps taken when the level was completed, -1 if it never was.
+
+	bool operator==(const ReplayOutcome& other) const { return score == other.score && lives == other.lives && completionStep == other.completionStep; }	//!< function to compare every field.
+	bool operator!=(const ReplayOutcome& other) const { return !(*this == other); }	//!< function to compare every field.
+};
+
+/*! \class InputRecording
+\brief The key presses and releases of a play session, indexed by physics step so it replays exactly at the fixed timestep.
+\ Saved as "CWIN", a version byte, then varints for the step count, the level name (length then bytes) and the outcome (a has-outcome flag, score, lives, completion step + 1),
+\ then the event count and each event as a varint step delta and one byte of key and pressed. Version 1 files, without the level name and outcome, still load.
+*/
+
+class InputRecording {
+public:
+	static const uint8_t version = 2;	//!< file format version, bump when the layout changes.
+
+	uint32_t stepCount = 0;			//!< how many physics steps the session ran for.
+	std::string levelName;			//!< the level played, as given to Game, empty for world 1-1.
+	bool hasOutcome = false;		//!< whether outcome was stored, recordings from before version 2 have none.
+	ReplayOutcome outcome;			//!< how the session ended.
+	std::vector<InputEvent> events;	//!< every input, in the order it was applied.
+
+	void clear();	//!< function to empty the recording.
+	void record(uint32_t step, sf::Keyboard::Key key, bool pressed);	//!< function to add an input applied before a step.
+	bool save(const std::string& fileName) const;	//!< function to write the recording.
+	bool load(const std::string& fileName);			//!< function to read a recording.
+};
+
+/*! \class InputReplay
+\brief Feeds a recording back into a Game through the same userInput() and stopMovement() calls the window events use.
+*/
+
+class InputReplay {
+private:
+	const InputRecording* recording = nullptr;	//!< the recording being replayed.
+	size_t nextEvent = 0;	//!< index of the next event to feed.
+public:
+	void start(const InputRecording* source);	//!< function to start replaying a recording from the beginning.
+	void feed(Game& game, uint32_t step);		//!< function to feed every input recorded before a step.
+	bool finished(uint32_t step) const;			//!< function to return whether the recording has run out at a step.
+};
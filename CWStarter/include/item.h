@@ -14,14 +14,10 @@
 
 class Item : public StaticRect
 {
-private:
-	void toBeRemovedCheck();	//!< function to check whether this object needs to be removed from the scene.
-	b2Vec2 b_objectPool;		//!< box2d vector2 for objectPool location, for moving the body of object.
-	sf::Vector2f sf_objectPool;	//!< sfml vector2 for objectPool location, for moving the sprite/texture of object.
 public:
 	Item() {}			//!< default constructor
 	~Item();			//!< deafult deconstructor
-	Item(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture); //!< complete constructor.
-	void update();		//!< function to update the rendering information for these objects.	
+	Item(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture); //!< complete constructor.
+	void despawn();		//!< function to take the item out of the world once collected, ready to return to its pool.
 	bool toRemove;		//!< bool to determine whether this object needs to be added to a removal list.
 };
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+/*!
+\file level.h
+*/
+#include <cstdint>
+#include <string>
+#include <vector>
+/*! \struct LevelEntity
+\brief One object placed in a level, laid out so a cooked level file can be read (or memory mapped) straight into an array of these.
+*/
+
+struct LevelEntity {
+	//! the types of object a level can place.
+	enum Kind {
+		PLAYER = 0,
+		ENEMY,
+		COIN,
+		OBSTACLE,
+		GROUND,
+		PLATFORM,
+		SENSOR,
+		KIND_COUNT
+	};
+
+	//! the textures a level object can be drawn with.
+	enum Texture {
+		NO_TEXTURE = 0,
+		STONES,
+		BRICK_1X1,
+		BRICK_2X1,
+		BRICK_3X1,
+		BRICK_4X1,
+		SOLID_BLOCK,
+		COIN_TEXTURE,
+		SMALL_TUBE,
+		BIG_TUBE,
+		FLAG,
+		GOOMBA,
+		MARIO,
+		TEXTURE_COUNT
+	};
+
+	uint8_t kind;		//!< what type of object, one of Kind.
+	uint8_t texture;	//!< what texture to draw it with, one of Texture.
+	uint16_t reserved;	//!< padding, kept at 0.
+	float x;			//!< x co-ord of the centre of the object.
+	float y;			//!< y co-ord of the centre of the object.
+	float width;		//!< width of the object.
+	float height;		//!< height of the object.
+};
+static_assert(sizeof(LevelEntity) == 20, "LevelEntity is read straight from cooked level files, its layout must not change");
+
+/*! \struct LevelHeader
+\brief Header at the start of a cooked level file, followed by the checkpoint floats, then (from version 2) the LevelChunkTable and its LevelChunks, then the LevelEntity array.
+*/
+struct LevelHeader {
+	char magic[4];				//!< always "CWLV".
+	uint32_t version;			//!< format version, LevelData::cookedVersion.
+	float startX;				//!< x co-ord the player respawns at before any checkpoint.
+	float startY;				//!< y co-ord the player respawns at.
+	float endPosition;			//!< x co-ord that completes the level.
+	uint32_t checkpointCount;	//!< number of checkpoint floats after the header.
+	uint32_t entityCount;		//!< number of LevelEntity records after the checkpoints.
+	uint32_t kindCounts[LevelEntity::KIND_COUNT];	//!< number of entities of each kind, so object lists can be reserved up front.
+};
+
+/*! \struct LevelChunk
+\brief One fixed width strip of a level along x, its entities are a contiguous run of the entity array so they can be read on their own.
+*/
+struct LevelChunk {
+	uint32_t firstEntity;	//!< index of the chunk's first entity in the whole level's entity array.
+	uint32_t entityCount;	//!< number of entities in the chunk.
+	float reach;			//!< furthest right edge of any entity in this chunk or an earlier one, so it never decreases along the table.
+};
+static_assert(sizeof(LevelChunk) == 12, "LevelChunk is read straight from cooked level files, its layout must not change");
+
+/*! \struct LevelChunkTable
+\brief Written after the checkpoints in a version 2 cooked level, followed by chunkCount LevelChunks.
+\ The entity array starts with the permanent entities, the players, then each chunk's entities in chunk order.
+*/
+struct LevelChunkTable {
+	float origin;			//!< x co-ord of the left edge of the first chunk.
+	float chunkWidth;		//!< width of every chunk.
+	uint32_t permanentCount;	//!< number of entities at the start of the array that belong to no chunk and are never streamed.
+	uint32_t chunkCount;	//!< number of chunks.
+};
+
+/*! \class LevelData
+\brief A whole level; the checkpoints, end position and every object to place. Loaded from a text description or a cooked binary.
+\ Split into chunks along x, each a run of the entities, so a level can be built around the camera a chunk at a time.
+\ When opened for streaming only the permanent entities are read, and each chunk's are read from chunkFile as it is needed.
+*/
+class LevelData {
+public:
+	static const uint32_t cookedVersion = 2;	//!< current version of the cooked format, version 1 has no chunk table and is still read.
+	static constexpr float defaultChunkWidth = 16.0f;	//!< chunk width levels are split with, a little over a screen.
+
+	float startX = 0.0f;			//!< x co-ord the player respawns at before any checkpoint.
+	float startY = 0.0f;			//!< y co-ord the player respawns at.
+	float endPosition = 0.0f;		//!< x co-ord that completes the level.
+	std::vector<float> checkpoints;	//!< x co-ords of the checkpoints, in increasing order.
+	std::vector<LevelEntity> entities;	//!< every object in the level.
+	uint32_t kindCounts[LevelEntity::KIND_COUNT] = {};	//!< number of entities of each kind.
+
+	float chunkOrigin = 0.0f;		//!< x co-ord of the left edge of the first chunk.
+	float chunkWidth = 0.0f;		//!< width of every chunk, 0 until the level is split.
+	uint32_t permanentCount = 0;	//!< number of entities at the start that belong to no chunk, the players.
+	std::vector<LevelChunk> chunks;	//!< the chunks, in order along x.
+	std::string chunkFile;			//!< cooked file the chunks' entities are read from when streaming, empty when entities holds them all.
+	uint64_t chunkFileOffset = 0;	//!< where the entity array starts in chunkFile.
+
+	bool loadText(const std::string& fileName);		//!< function to parse a text level description.
+	bool loadCooked(const std::string& fileName);	//!< function to read a cooked binary level in one go.
+	bool openCooked(const std::string& fileName);	//!< function to read all of a cooked level but its chunks' entities, which are streamed from the file.
+	bool saveCooked(const std::string& fileName) const;	//!< function to write this level as a cooked binary.
+	void addEntity(const LevelEntity& entity);		//!< function to add an object to the level, keeping the kind counts up to date.
+	void clear();									//!< function to empty the level.
+	void buildChunks(float width);					//!< function to sort the entities into chunks of a width and build the chunk table.
+	int firstChunkReaching(float x) const;			//!< function to return the first chunk with an entity reaching x or further right.
+	int chunkEnd(float x) const;					//!< function to return one past the last chunk starting at or left of x.
+	uint32_t totalEntities() const { return chunks.empty() ? permanentCount : chunks.back().firstEntity + chunks.back().entityCount; }	//!< function to return the number of entities, streamed ones included.
+
+	static const char* kindName(int kind);			//!< function to return the text name of an entity kind.
+	static bool validKinds(const LevelEntity* entities, size_t count, bool players);	//!< function to check every entity read from a file is of a known kind, and all players or none.
+	static bool validChunks(const std::vector<LevelChunk>& chunks, uint32_t permanentCount, uint64_t entityCount);	//!< function to check a chunk table read from a file covers the entities exactly.
+	static const char* textureName(int texture);	//!< function to return the text name of a texture.
+};
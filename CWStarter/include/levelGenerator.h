@@ -0,0 +1,48 @@
+#pragma once
+/*!
+\file levelGenerator.h
+*/
+#include <cstdint>
+#include <random>
+#include <string>
+#include "level.h"
+
+/*! \struct GeneratorSettings
+\brief What a generated level should hold, densities are per screen (12 metres, one ground block).
+*/
+
+struct GeneratorSettings {
+	uint32_t seed = 1;					//!< the same seed and settings always give the same level.
+	int screens = 10;					//!< length of the level in screens.
+	float enemiesPerScreen = 1.0f;		//!< goombas per screen, the fraction is a chance of one more.
+	float coinsPerScreen = 4.0f;		//!< coins per screen.
+	float obstaclesPerScreen = 1.0f;	//!< tubes per screen.
+	float platformsPerScreen = 1.5f;	//!< brick platforms per screen.
+	float gapChance = 0.15f;			//!< chance of a screen ending in a jumpable gap.
+};
+
+/*! \class LevelGenerator
+\brief Builds LevelData procedurally, either a seeded platformer layout of any length and density or one of the canned stress scenes.
+\ The results use the same kinds, textures and sizes as the hand made level, so Game builds them exactly as it does world 1-1.
+*/
+
+class LevelGenerator {
+public:
+	static const int screenWidth = 12;		//!< width of a screen, and of the ground block under it.
+	static const uint32_t maxPerKind = 0xFFFE;	//!< most objects of one kind, BodyTag indices and pool slots are 16 bit.
+private:
+	std::mt19937 random;	//!< seeded generator, only its raw output is used so levels are the same on every platform.
+
+	float uniform(float low, float high);	//!< function to return a random float in [low, high).
+	int countFor(float perScreen);			//!< function to turn a density into a whole count, rounding by chance.
+	static void add(LevelData& level, uint8_t kind, uint8_t texture, float x, float y, float width, float height);	//!< function to add an object if its kind is not full.
+	static void addStart(LevelData& level);	//!< function to add the player, respawn point and sensor where world 1-1 has them.
+public:
+	void generate(const GeneratorSettings& settings, LevelData& level);	//!< function to fill a level with a seeded layout.
+
+	static void pileUp(int enemies, LevelData& level);	//!< function to build a walled pit of stacked goombas by the start.
+	static void coinCarpet(int coins, LevelData& level);	//!< function to build a long flat run carpeted with coins.
+	static void tubeForest(int screens, LevelData& level);	//!< function to build a run of packed tubes with a goomba between each pair.
+
+	static bool fromSpec(const std::string& spec, LevelData& level);	//!< function to build a level from "gen:seed:screens[:enemies[:coins]]" or "scene:name[:count]".
+};
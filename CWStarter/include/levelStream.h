@@ -0,0 +1,57 @@
+#pragma once
+/*!
+\file levelStream.h
+*/
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "level.h"
+#include "spscQueue.h"
+
+/*! \class LevelStream
+\brief Reads a level's chunks on a thread of its own, ahead of the camera, so building a chunk into the world never waits on the disk.
+\ The game thread asks for chunks with prefetch() and collects them with take(), which reads a chunk there and then if it was never asked for.
+\ Chunks are read from the cooked file when the level was opened for streaming, otherwise copied out of the level in memory.
+*/
+
+class LevelStream {
+public:
+	/*! \struct Chunk
+	\brief One chunk's entities, read and ready to be built into the world.
+	*/
+	struct Chunk {
+		int index = 0;						//!< which chunk.
+		std::vector<LevelEntity> entities;	//!< its entities, in level order.
+	};
+	static const size_t maxRequested = 32;	//!< most chunks asked for and not yet taken, so neither queue can fill.
+private:
+	std::shared_ptr<const LevelData> level;	//!< the level being streamed.
+
+	//game thread only.
+	std::ifstream gameFile;					//!< the cooked file, for chunks read on the game thread.
+	std::vector<int> requested;				//!< chunks asked for and not yet taken or forgotten.
+	std::vector<std::unique_ptr<Chunk>> arrived;	//!< chunks read that came off the queue before the one waited for.
+	SpscQueue<int, 64> requests;			//!< chunks to read, from the game thread to the stream thread.
+	SpscQueue<Chunk*, 64> results;			//!< chunks read, from the stream thread back, owned by the queue until popped.
+
+	//stream thread only.
+	std::ifstream streamFile;				//!< the cooked file, for chunks read on the stream thread.
+
+	std::atomic<bool> running{ false };		//!< cleared to stop the stream thread.
+	std::thread thread;						//!< the stream thread, only started when threaded.
+
+	void run();	//!< function run by the stream thread, reading chunks as they are asked for until stopped.
+	bool read(std::ifstream& file, int index, Chunk& chunk) const;	//!< function to read one chunk's entities.
+	void collect();	//!< function to move every chunk read so far off the results queue.
+	void unrequest(int index);	//!< function to take a chunk off the requested list.
+public:
+	~LevelStream();	//!< deconstructor, stops the stream thread.
+
+	void open(std::shared_ptr<const LevelData> streamed, bool threaded);	//!< function to start streaming a level, on a thread of its own if threaded.
+	void close();	//!< function to stop the stream thread and drop every chunk not yet taken.
+	bool prefetch(int index);	//!< function to ask for a chunk to be read in the background.
+	std::unique_ptr<Chunk> take(int index);	//!< function to return a chunk, waiting for it or reading it now if need be.
+	void forget(int first, int end);	//!< function to drop chunks read or asked for outside a range, no longer needed.
+};
@@ -0,0 +1,160 @@
+#pragma once
+/*!
+\file objectPool.h
+*/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+/*! \class ObjectPool
+\brief Fixed slots of objects, with a dense list of the active slots and a free list of released ones.
+\ Slots never move, so a slot index can be kept in a body tag. Acquire and release are O(1), and iterating active() only visits live objects.
+\ A slot can also be deactivated without being released, held for whoever owns it to reactivate or release later.
+*/
+
+template <typename T>
+class ObjectPool {
+private:
+	static const uint16_t notActive = 0xFFFF;	//!< activePosition value for a slot that has been released.
+	static const uint16_t held = 0xFFFE;		//!< activePosition value for a slot that has been deactivated but not released.
+
+	std::vector<T> slots;					//!< every object, active or released.
+	std::vector<uint16_t> activeSlots;		//!< dense list of the active slots.
+	std::vector<uint16_t> activePosition;	//!< where each slot is in activeSlots, or held or notActive.
+	std::vector<uint16_t> freeSlots;		//!< released slots, ready to be acquired again.
+
+	//! Function to take a slot out of the dense active list.
+	/*!
+	\param uint16_t slot - an active slot.
+	*/
+	void removeActive(uint16_t slot)
+	{
+		//move the last active slot into the gap, keeping the list dense.
+		uint16_t position = activePosition[slot];
+		uint16_t last = activeSlots.back();
+		activeSlots[position] = last;
+		activePosition[last] = position;
+		activeSlots.pop_back();
+	}
+public:
+	//! Function to reserve room for a number of objects, so adding them won't reallocate.
+	/*!
+	\param size_t count - how many objects the pool will hold.
+	*/
+	void reserve(size_t count)
+	{
+		slots.reserve(count);
+		activeSlots.reserve(count);
+		activePosition.reserve(count);
+		freeSlots.reserve(count);
+	}
+
+	//! Function to add a new object in a new, active, slot. Used when loading, it can allocate.
+	/*!
+	\param T object - the object to add.
+	\return uint16_t - the slot it was added in.
+	*/
+	uint16_t add(const T& object)
+	{
+		uint16_t slot = (uint16_t)slots.size();
+		slots.push_back(object);
+		activePosition.push_back((uint16_t)activeSlots.size());
+		activeSlots.push_back(slot);
+		return slot;
+	}
+
+	//! Function to take a released slot for reuse, without allocating.
+	/*!
+	\param uint16_t slot - set to the slot acquired.
+	\return bool - false if no slot is free.
+	*/
+	bool acquire(uint16_t& slot)
+	{
+		if (freeSlots.empty())
+		{
+			return false;
+		}
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+		activePosition[slot] = (uint16_t)activeSlots.size();
+		activeSlots.push_back(slot);
+		return true;
+	}
+
+	//! Function to add an object, in a released slot if there is one so the pool only grows to the most objects active at once.
+	/*!
+	\param T object - the object to add.
+	\return uint16_t - the slot it was put in.
+	*/
+	uint16_t place(const T& object)
+	{
+		uint16_t slot;
+		if (acquire(slot))
+		{
+			slots[slot] = object;
+			return slot;
+		}
+		return add(object);
+	}
+
+	//! Function to take an active slot out of the active list, without releasing it for reuse.
+	/*!
+	\param uint16_t slot - the slot to deactivate.
+	*/
+	void deactivate(uint16_t slot)
+	{
+		if (activePosition[slot] >= held)
+		{
+			return;
+		}
+		removeActive(slot);
+		activePosition[slot] = held;
+	}
+
+	//! Function to put a deactivated slot back in the active list.
+	/*!
+	\param uint16_t slot - the slot to reactivate.
+	*/
+	void reactivate(uint16_t slot)
+	{
+		if (activePosition[slot] != held)
+		{
+			return;
+		}
+		activePosition[slot] = (uint16_t)activeSlots.size();
+		activeSlots.push_back(slot);
+	}
+
+	//! Function to release an active or deactivated slot, it leaves the active list straight away and can be acquired again.
+	/*!
+	\param uint16_t slot - the slot to release.
+	*/
+	void release(uint16_t slot)
+	{
+		if (activePosition[slot] == notActive)
+		{
+			return;
+		}
+		if (activePosition[slot] != held)
+		{
+			removeActive(slot);
+		}
+		activePosition[slot] = notActive;
+		freeSlots.push_back(slot);
+	}
+
+	//! Function to empty the pool.
+	void clear()
+	{
+		slots.clear();
+		activeSlots.clear();
+		activePosition.clear();
+		freeSlots.clear();
+	}
+
+	bool isActive(uint16_t slot) const { return activePosition[slot] < held; }	//!< function to return whether a slot is active.
+	const std::vector<uint16_t>& active() const { return activeSlots; }	//!< function to return the active slots, in no particular order.
+	size_t size() const { return slots.size(); }	//!< function to return how many slots there are, active or not.
+
+	T& operator[](size_t slot) { return slots[slot]; }				//!< function to return the object in a slot.
+	const T& operator[](size_t slot) const { return slots[slot]; }	//!< function to return the object in a slot.
+};
@@ -13,5 +13,6 @@ class Obstacle : public sf::RectangleShape, public PhysicalObject {
 public:
 	Obstacle() {};	//!< default constructor.
 	~Obstacle() {};	//!< default deconstructor.
-	Obstacle(b2World* world, const sf::Vector2f& position, const sf::Vector2f& size, const float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture);		//!< complete constructor.
+	Obstacle(b2World* world, const sf::Vector2f& position, const sf::Vector2f& size, const float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture);		//!< complete constructor.
+	Obstacle(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Texture* texture);	//!< constructor for one only drawn, its collision merged into a chunk's StaticGeometry.
 };
\ No newline at end of file
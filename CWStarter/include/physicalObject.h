@@ -4,6 +4,7 @@
 */
 #include <Box2D/Box2D.h>
 #include <iostream>
+#include "bodyTag.h"
 #define DEG2RAD 0.017453f
 #define RAD2DEG 57.29577f
 /*!
@@ -33,6 +34,7 @@ public:
 	};	//!< enums for collision filtering, principle types of objects that will be within the world.
 
 	void setUserData(void* data) { body->SetUserData(data); }	//!< function to set the user data of a body.
+	void setTag(BodyTag tag) { body->SetUserData(tag.toUserData()); }	//!< function to tag the body for the contact listener.
 	b2Body* getBody() const { return body; }	//!< function to return the body element of an object.
 
 	//! Function to load a texture.
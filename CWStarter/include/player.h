@@ -18,6 +18,5 @@ private:
 public:
 	Player() {};		//!< default constructor.
 	~Player() {};		//!< default deconstructor.
-	Player(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture, sf::Sprite* sprite, int frames, float animDur); //!< complete constructor.
-	void update();		//!< function to update the rendering information for these objects.	
+	Player(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture, sf::Sprite* sprite, int frames, float animDur); //!< complete constructor.
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+/*!
+\file profiler.h
+\brief Per stage frame timing, kept in a ring buffer and drawn as a stacked frame time graph.
+\ Game only uses it when PROFILING is defined (the Debug configuration), otherwise PROFILE_SCOPE compiles to nothing.
+*/
+#include <Box2D/Box2D.h>
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include "tracer.h"
+
+//! the stages of a frame that are timed, in the order they are stacked on the graph.
+enum ProfileStage {
+	STAGE_STREAMING = 0,	//!< building chunks of the level into the world ahead of the camera and tearing them down behind it.
+	STAGE_ACTIVATION,		//!< waking and sleeping enemies, saving previous transforms.
+	STAGE_STEP,				//!< world->Step and reading back the body transforms.
+	STAGE_CONTACTS,			//!< polling the contact listener, releasing removed objects, death and sfx.
+	STAGE_PLAYER,			//!< falling off screen and player movement.
+	STAGE_ANIMATION,		//!< player animation.
+	STAGE_UI,				//!< updating the UI text.
+	STAGE_ENTITIES,			//!< culling to the view and stepping the enemies.
+	STAGE_RULES,			//!< checkpoints, level complete and win/lose conditions.
+	STAGE_INTERPOLATE,		//!< render interpolation and the camera.
+	STAGE_DRAW,				//!< building and issuing the draws.
+	STAGE_COUNT
+};
+
+const char* profileStageName(ProfileStage stage);	//!< function to return the name of a stage, as shown in the legend and trace.
+
+/*! \struct ProfileFrame
+\brief The timings of one rendered frame, all in milliseconds.
+*/
+
+struct ProfileFrame {
+	float stageMs[STAGE_COUNT];	//!< time spent in each stage, summed over every physics step in the frame.
+	float collideMs;			//!< Box2D narrow phase time, from b2World::GetProfile().
+	float solveMs;				//!< Box2D solver time.
+	float broadphaseMs;			//!< Box2D broadphase time.
+	int32 bodyCount;			//!< bodies in the world at the end of the frame.
+	int32 contactCount;			//!< contacts in the world at the end of the frame.
+};
+
+/*! \class FrameProfiler
+\brief Collects the stage timings of the current frame, then keeps the last frameHistory frames in a ring buffer for the overlay.
+*/
+
+class FrameProfiler : public sf::Drawable {
+public:
+	static const int frameHistory = 240;	//!< frames kept, four seconds at 60 per second.
+private:
+	ProfileFrame frames[frameHistory];	//!< ring buffer of finished frames.
+	int newestFrame = 0;				//!< index of the most recently finished frame.
+	ProfileFrame current;				//!< the frame being timed.
+	const sf::Font* font = nullptr;		//!< font for the legend.
+
+	mutable sf::VertexArray graph;		//!< stacked bars, rebuilt each draw.
+	mutable sf::Text legend;			//!< average time of each stage.
+public:
+	FrameProfiler();	//!< constructor, starts with empty frames.
+
+	void setFont(const sf::Font* legendFont);	//!< function to set the font the legend is drawn with.
+	void addStageTime(ProfileStage stage, float ms) { current.stageMs[stage] += ms; }	//!< function to add time to a stage of the current frame.
+	void addWorldProfile(const b2Profile& profile);	//!< function to add the Box2D profile of one step to the current frame.
+	void endFrame(const b2World* world);	//!< function to finish the current frame into the ring buffer and start the next.
+	const ProfileFrame& getFrame(int age) const;	//!< function to return a finished frame, 0 the newest.
+
+	void draw(sf::RenderTarget &target, sf::RenderStates states) const;	//!< function to draw the stacked graph and legend, in UI co-ords.
+};
+
+/*! \class ScopedTimer
+\brief Times from its construction to the end of its scope, adding the time to a stage.
+*/
+
+class ScopedTimer {
+private:
+	FrameProfiler& profiler;	//!< profiler to add the time to.
+	ProfileStage stage;			//!< stage being timed.
+	std::chrono::high_resolution_clock::time_point start;	//!< when the scope was entered.
+public:
+	ScopedTimer(FrameProfiler& target, ProfileStage timedStage) : profiler(target), stage(timedStage), start(std::chrono::high_resolution_clock::now()) {}	//!< constructor, starts timing.
+	~ScopedTimer()
+	{
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+		profiler.addStageTime(stage, elapsed.count());
+	}	//!< destructor, adds the time to the stage.
+};
+
+#ifdef PROFILING
+#define PROFILE_JOIN2(a, b) a##b
+#define PROFILE_JOIN(a, b) PROFILE_JOIN2(a, b)
+//! times the rest of the enclosing scope as a stage.
+#define PROFILE_SCOPE(profiler, stage) ScopedTimer PROFILE_JOIN(scopedTimer, __LINE__)(profiler, stage)
+#else
+#define PROFILE_SCOPE(profiler, stage)
+#endif
+
+//! times the rest of the enclosing scope as a stage for the overlay, and records it as a span while tracing.
+#define STAGE_SCOPE(profiler, stage) PROFILE_SCOPE(profiler, stage); TRACE_SCOPE(profileStageName(stage), "stage")
@@ -0,0 +1,36 @@
+#pragma once
+/*!
+\file replayFarm.h
+*/
+#include <string>
+#include <vector>
+#include "inputRecording.h"
+
+/*! \struct ReplayResult
+\brief What happened when one recording was replayed.
+*/
+
+struct ReplayResult {
+	std::string fileName;		//!< the recording.
+	bool loaded = false;		//!< whether the file loaded.
+	bool hasExpected = false;	//!< whether the recording stored an outcome to check against.
+	ReplayOutcome expected;		//!< the outcome stored with the recording.
+	ReplayOutcome actual;		//!< the outcome of the replay.
+	uint32_t steps = 0;			//!< physics steps replayed.
+
+	bool passed() const { return loaded && (!hasExpected || expected == actual); }	//!< function to return whether it loaded and, if it could be checked, matched.
+};
+
+/*! \class ReplayFarm
+\brief Replays recordings headless on a pool of threads, each replay in its own Game and b2World, and checks each against its stored outcome.
+\ Workers take the next recording off a shared counter, so long and short replays even out across the cores without any locking.
+*/
+
+class ReplayFarm {
+private:
+	static void warmUp();	//!< function to initialise Box2D's shared lookup tables on the calling thread, before any worker makes a world.
+public:
+	static ReplayOutcome simulate(const InputRecording& recording);	//!< function to replay a recording to its end in a new Game and return how it ended.
+	static std::vector<std::string> findRecordings(const std::string& path);	//!< function to list the .cwin recordings in a directory, or just the file if path is one.
+	static std::vector<ReplayResult> run(const std::vector<std::string>& fileNames, unsigned threadCount, bool bless);	//!< function to replay every recording, blessing them with their outcome if asked.
+};
@@ -0,0 +1,35 @@
+#pragma once
+/*!
+\file spatialIndex.h
+*/
+#include <vector>
+#include "bodyTag.h"
+/*! \class SpatialIndex
+\brief A 1D grid of equal width cells along the x-axis, holding the static objects of the part of the level built into the world.
+\ A query returns the objects overlapping an x range by visiting only the cells it covers, so its cost follows what is on screen rather than the level length.
+\ The grid wraps around, x co-ords a grid's width apart share a cell, so a grid as wide as the streamed part of the level serves a level of any length.
+*/
+
+class SpatialIndex {
+private:
+	//! one object in the index, stored in every cell it overlaps.
+	struct Entry {
+		BodyTag tag;	//!< the object this entry is for.
+		float left;		//!< left edge of the object.
+		float right;	//!< right edge of the object.
+		int firstCell;	//!< leftmost cell the object is in, before wrapping, so a query spanning several of its cells reports it once.
+	};
+
+	float minX = 0.0f;		//!< left edge of the first cell.
+	float cellWidth = 1.0f;	//!< width of each cell.
+	std::vector<std::vector<Entry>> cells;	//!< the objects overlapping each cell.
+
+	int cellFor(float x) const;	//!< function to return the cell an x co-ord is in, before wrapping.
+	std::vector<Entry>& wrap(int cell) { return cells[((cell % (int)cells.size()) + (int)cells.size()) % (int)cells.size()]; }	//!< function to return the entries of a cell, wrapped onto the grid.
+	const std::vector<Entry>& wrap(int cell) const { return cells[((cell % (int)cells.size()) + (int)cells.size()) % (int)cells.size()]; }	//!< function to return the entries of a cell, wrapped onto the grid.
+public:
+	void build(float left, float right, float width);	//!< function to empty the index and size it to span a range of x before wrapping.
+	void insert(BodyTag tag, float left, float right);	//!< function to add an object spanning an x range.
+	void remove(BodyTag tag, float left, float right);	//!< function to take out an object added with the same x range.
+	void query(float left, float right, std::vector<BodyTag>& results) const;	//!< function to find every object overlapping an x range.
+};
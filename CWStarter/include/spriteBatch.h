@@ -0,0 +1,32 @@
+#pragma once
+/*!
+\file spriteBatch.h
+*/
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "transformStore.h"
+/*! \class SpriteBatch
+\brief Gathers textured rectangles into one vertex array per texture, so a frame costs one draw call per texture rather than one per object.
+\ Batches are drawn in the order their texture was first added, and keep their memory between frames.
+*/
+
+class SpriteBatch : public sf::Drawable {
+private:
+	//! all the quads sharing one texture.
+	struct Batch {
+		const sf::Texture* texture;	//!< texture every quad in this batch is drawn with.
+		sf::VertexArray quads;		//!< four vertices per rectangle.
+	};
+
+	std::vector<Batch> batches;	//!< batches used this frame come first, spare ones after are kept for reuse.
+	size_t usedBatches = 0;		//!< number of batches used this frame.
+
+	Batch& batchFor(const sf::Texture* texture);	//!< function to find, or start, the batch for a texture.
+	void addQuad(Batch& batch, const sf::Vector2f corners[4], const sf::IntRect& rect, const sf::Color& colour);	//!< function to append one textured quad.
+public:
+	void clear();		//!< function to empty every batch, keeping their memory.
+	void add(const sf::RectangleShape& shape);	//!< function to add a rectangle shape, with its transform, texture rect and colour.
+	void add(const sf::Texture* texture, const TransformStore& store, size_t index);	//!< function to add an entry of a transform store, at its render transform.
+	void draw(sf::RenderTarget &target, sf::RenderStates states) const;	//!< function to draw each batch in one call.
+	size_t getDrawCallCount() const { return usedBatches; }	//!< function to return how many draw calls the batch will make.
+};
@@ -0,0 +1,86 @@
+#pragma once
+/*!
+\file spscQueue.h
+*/
+#include <atomic>
+#include <cstddef>
+/*! \class SpscQueue
+\brief Fixed size ring buffer for one producer thread and one consumer thread, with no locks and no allocation after construction.
+\ The producer only writes tail and the consumer only writes head, each published with release and read with acquire, so the items between them are always fully written.
+\ Capacity must be a power of two, a push to a full queue fails rather than overwriting.
+*/
+
+template <typename T, size_t Capacity>
+class SpscQueue {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+private:
+	static const size_t mask = Capacity - 1;	//!< turns a running count into a slot.
+
+	alignas(64) std::atomic<size_t> head{ 0 };	//!< items popped so far, written by the consumer, on its own cache line.
+	alignas(64) std::atomic<size_t> tail{ 0 };	//!< items pushed so far, written by the producer, on its own cache line.
+	alignas(64) T items[Capacity];				//!< the ring.
+public:
+	//! Function to add an item, from the producer thread.
+	/*!
+	\param T item - the item.
+	\return bool - false if the queue was full and the item was not added.
+	*/
+	bool push(const T& item)
+	{
+		size_t pushed = tail.load(std::memory_order_relaxed);
+		if (pushed - head.load(std::memory_order_acquire) == Capacity)
+		{
+			return false;
+		}
+		items[pushed & mask] = item;
+		tail.store(pushed + 1, std::memory_order_release);
+		return true;
+	}
+
+	//! Function to take the oldest item, from the consumer thread.
+	/*!
+	\param T item - set to the item taken.
+	\return bool - false if the queue was empty.
+	*/
+	bool pop(T& item)
+	{
+		size_t popped = head.load(std::memory_order_relaxed);
+		if (popped == tail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		item = items[popped & mask];
+		head.store(popped + 1, std::memory_order_release);
+		return true;
+	}
+
+	//! Function to take up to a batch of the oldest items at once, from the consumer thread, publishing the new head once for them all.
+	/*!
+	\param T batch - array to copy the items into, in order.
+	\param size_t maxCount - size of the array.
+	\return size_t - how many items were taken, 0 if the queue was empty.
+	*/
+	size_t popBatch(T* batch, size_t maxCount)
+	{
+		size_t popped = head.load(std::memory_order_relaxed);
+		size_t available = tail.load(std::memory_order_acquire) - popped;
+		size_t count = available < maxCount ? available : maxCount;
+		for (size_t i = 0; i < count; i++)
+		{
+			batch[i] = items[(popped + i) & mask];
+		}
+		head.store(popped + count, std::memory_order_release);
+		return count;
+	}
+
+	//! Function to return roughly how many items are waiting, exact when called from either end with the other idle.
+	/*!
+	\return size_t - the count.
+	*/
+	size_t size() const
+	{
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+	}
+
+	static size_t capacity() { return Capacity; }	//!< function to return how many items fit.
+};
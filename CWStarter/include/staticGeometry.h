@@ -0,0 +1,35 @@
+#pragma once
+/*!
+\file staticGeometry.h
+*/
+#include <Box2D/Box2D.h>
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "physicalObject.h"
+/*! \class StaticGeometry
+\brief The collision of a chunk's ground blocks and obstacles, merged into outlines on one static body.
+\ Blocks of the same kind and filter that overlap or touch are unioned, and each outline of the union becomes a b2ChainShape loop,
+\ so a run of blocks is a handful of fixtures instead of one body each, and nothing snags on the seams between them.
+\ Each loop's fixture is tagged with the first block it was made from, so the contact listener still tells ground from obstacles.
+*/
+
+class StaticGeometry : public PhysicalObject {
+public:
+	static const int snapPerMetre = 128;	//!< block edges are snapped to this grid, coarser than b2_linearSlop so no outline has edges too short for Box2D.
+private:
+	/*! \struct Block
+	\brief One block to merge, its edges in snapped units.
+	*/
+	struct Block {
+		BodyTag tag;			//!< the drawn object it came from.
+		uint16 categoryBits;	//!< what type of object it is.
+		uint16 maskBits;		//!< what it collides with.
+		sf::IntRect rect;		//!< its bounds, in snapped units.
+	};
+	std::vector<Block> blocks;	//!< blocks added since the last build.
+public:
+	void add(BodyTag tag, const sf::FloatRect& bounds, uint16 categoryBits, uint16 maskBits);	//!< function to add a block to be merged.
+	void build(b2World* world);		//!< function to merge the blocks added and create the body with a loop for each outline.
+	void destroy(b2World* world);	//!< function to destroy the body and forget the blocks.
+	static void outline(const std::vector<sf::IntRect>& rects, std::vector<std::vector<sf::Vector2i>>& loops);	//!< function to trace the outlines of a union of rectangles.
+};
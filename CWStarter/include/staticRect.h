@@ -13,5 +13,6 @@ class StaticRect : public sf::RectangleShape, public PhysicalObject {
 public:
 	StaticRect() {};	//!< default constructor.
 	~StaticRect() {};	//!< default deconstructor.
-	StaticRect(b2World* world, const sf::Vector2f& position, const sf::Vector2f& size, const float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture);	//!< complete constructor 
+	StaticRect(b2World* world, const sf::Vector2f& position, const sf::Vector2f& size, const float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture);	//!< complete constructor 
+	StaticRect(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Texture* texture);	//!< constructor for one only drawn, its collision merged into a chunk's StaticGeometry.
 };
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+/*!
+\file textureAtlas.h
+*/
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <string>
+#include <vector>
+/*! \class TextureAtlas
+\brief All the game textures packed into one image, with a table giving each texture's rect within it.
+\ The atlas is packed offline by CWAtlasPack and loaded with a single decode and upload, or packed in memory if it hasn't been built.
+*/
+
+class TextureAtlas {
+private:
+	sf::Texture texture;	//!< the packed image, uploaded once.
+	std::map<std::string, sf::IntRect> rects;	//!< rect of each packed texture, keyed by its file name.
+public:
+	static const int padding = 2;	//!< empty pixels left around each texture so neighbours never bleed together.
+	static const unsigned placeholderSize = 32;	//!< width and height of the placeholder packed for a missing texture.
+
+	bool loadFromFile(const std::string& directory, const std::string& tableName);	//!< function to load a packed atlas and its table.
+	bool decode(const std::string& directory, const std::string& tableName, sf::Image& image);	//!< function to read a packed atlas table and decode its image, without uploading it.
+	bool pack(const std::string& directory, const std::vector<std::string>& fileNames, sf::Image& image, bool placeholders = false);	//!< function to pack separate textures into one image, optionally standing in for missing ones.
+	bool saveToFile(const sf::Image& image, const std::string& directory, const std::string& imageName, const std::string& tableName) const;	//!< function to save a packed image and its table.
+	bool upload(const sf::Image& image);	//!< function to upload a packed image to the atlas texture.
+
+	sf::Texture* getTexture() { return &texture; }	//!< function to return the atlas texture every packed texture is drawn from.
+	const sf::Texture* getTexture() const { return &texture; }	//!< function to return the atlas texture every packed texture is drawn from.
+	sf::IntRect getRect(const std::string& fileName) const;	//!< function to return the rect of a packed texture.
+	size_t getCount() const { return rects.size(); }	//!< function to return how many textures are packed.
+	static void placeholder(sf::Image& image, unsigned width, unsigned height);	//!< function to fill an image with the checkerboard drawn for a missing texture.
+
+	//! Function to offset a rect within a packed texture, such as a spritesheet frame, to its place in the atlas.
+	/*!
+	\param sf::IntRect rect - the rect of the packed texture in the atlas.
+	\param sf::IntRect local - the rect within that texture, a negative width or height still flips it.
+	\return sf::IntRect - the rect within the atlas.
+	*/
+	static sf::IntRect subRect(const sf::IntRect& rect, const sf::IntRect& local)
+	{
+		return sf::IntRect(rect.left + local.left, rect.top + local.top, local.width, local.height);
+	}
+};
@@ -0,0 +1,95 @@
+#pragma once
+/*!
+\file tracer.h
+\brief Captures spans and instant events into per thread buffers, then writes them out as a chrome://tracing / Perfetto JSON trace.
+\ Game and the entry points only record events when TRACING is defined, otherwise TRACE_SCOPE and TRACE_INSTANT compile to nothing.
+*/
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*! \struct TraceEvent
+\brief One recorded event, names are pointers to string literals or other strings that outlive the capture.
+*/
+
+struct TraceEvent {
+	const char* name;		//!< event name, shown on the span.
+	const char* category;	//!< event category, "frame", "stage", "draw", "contact", "decode", "upload" or "stream".
+	const char* detail;		//!< optional argument shown with the event, nullptr for none.
+	int64_t startNs;		//!< nanoseconds since the capture started.
+	int64_t durationNs;		//!< length of the span, or -1 for an instant event.
+};
+
+/*! \struct TraceBuffer
+\brief Preallocated events of a single thread, so recording never allocates or locks.
+\ writing is set while its thread is inside record(), so start() and stop() can wait for it to finish before touching the events.
+*/
+
+struct TraceBuffer {
+	std::vector<TraceEvent> events;	//!< allocated to capacity when the thread first records.
+	size_t count = 0;				//!< events recorded in this capture.
+	size_t dropped = 0;				//!< events lost because the buffer was full.
+	uint32_t threadId = 0;			//!< tid written to the trace, in order of first use.
+	std::atomic<bool> writing{ false };	//!< set by its thread while it records, the only time it touches the events.
+};
+
+/*! \class Tracer
+\brief Starts and stops a capture, records into the calling thread's buffer and flushes every buffer to a file at the end.
+*/
+
+class Tracer {
+public:
+	static const size_t defaultCapacity = 1 << 18;	//!< events per thread, a little over a minute of a busy frame at 60 per second.
+private:
+	static std::atomic<bool> capturing;				//!< whether events are being recorded.
+	static std::atomic<int64_t> epochNs;			//!< clock time the capture started, event times are relative to it.
+	static size_t capacity;							//!< events per thread for this capture.
+	static std::mutex registryMutex;				//!< guards buffers, only taken the first time a thread records.
+	static std::vector<TraceBuffer*> buffers;		//!< every thread's buffer, so stop() can flush them all.
+
+	static TraceBuffer& threadBuffer();			//!< function to return the calling thread's buffer, registering it the first time.
+	static void waitForWriters();				//!< function to wait for every thread recording when capturing was cleared to finish.
+	static void record(const TraceEvent& event);	//!< function to append to the calling thread's buffer.
+public:
+	static void start(size_t eventsPerThread = defaultCapacity);	//!< function to clear the buffers and start recording.
+	static bool stop(const std::string& fileName);	//!< function to stop recording and write the trace, returns false if it couldn't be written.
+	static bool isCapturing() { return capturing.load(std::memory_order_relaxed); }	//!< function to return whether a capture is running.
+	static int64_t now();	//!< function to return the clock time in nanoseconds.
+
+	static void complete(const char* name, const char* category, int64_t startNs, int64_t endNs);	//!< function to record a finished span.
+	static void instant(const char* name, const char* category, const char* detail);	//!< function to record an instant event.
+};
+
+/*! \class ScopedTrace
+\brief Records a span from its construction to the end of its scope, if a capture is running when it starts.
+*/
+
+class ScopedTrace {
+private:
+	const char* name;		//!< span name.
+	const char* category;	//!< span category.
+	int64_t start;			//!< when the scope was entered, -1 if not capturing.
+public:
+	ScopedTrace(const char* spanName, const char* spanCategory) : name(spanName), category(spanCategory), start(Tracer::isCapturing() ? Tracer::now() : -1) {}	//!< constructor, notes the start time.
+	~ScopedTrace()
+	{
+		if (start >= 0)
+		{
+			Tracer::complete(name, category, start, Tracer::now());
+		}
+	}	//!< destructor, records the span.
+};
+
+#ifdef TRACING
+#define TRACE_JOIN2(a, b) a##b
+#define TRACE_JOIN(a, b) TRACE_JOIN2(a, b)
+//! records the rest of the enclosing scope as a span.
+#define TRACE_SCOPE(name, category) ScopedTrace TRACE_JOIN(scopedTrace, __LINE__)(name, category)
+//! records an instant event, detail is only evaluated while capturing.
+#define TRACE_INSTANT(name, category, detail) do { if (Tracer::isCapturing()) Tracer::instant(name, category, detail); } while (0)
+#else
+#define TRACE_SCOPE(name, category)
+#define TRACE_INSTANT(name, category, detail) do {} while (0)
+#endif
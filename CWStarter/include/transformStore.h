@@ -0,0 +1,39 @@
+#pragma once
+/*!
+\file transformStore.h
+*/
+#include <Box2D/Box2D.h>
+#include <SFML/Graphics.hpp>
+#include <vector>
+/*! \class TransformStore
+\brief Structure of arrays holding what rendering needs from each moving object: its body, the transforms of the last two physics steps, the interpolated render transform, size and sprite rect.
+\ The sync passes each walk a contiguous range of entries, so they touch only the arrays they need rather than whole objects.
+*/
+
+class TransformStore {
+public:
+	std::vector<b2Body*> bodies;		//!< body of each entry, only read when capturing.
+	std::vector<float> previousX;		//!< body x at the start of the last physics step.
+	std::vector<float> previousY;		//!< body y at the start of the last physics step.
+	std::vector<float> previousAngle;	//!< body angle at the start of the last physics step.
+	std::vector<float> currentX;		//!< body x after the last physics step.
+	std::vector<float> currentY;		//!< body y after the last physics step.
+	std::vector<float> currentAngle;	//!< body angle after the last physics step.
+	std::vector<float> renderX;			//!< interpolated x to draw at.
+	std::vector<float> renderY;			//!< interpolated y to draw at.
+	std::vector<float> renderAngle;		//!< interpolated angle to draw at, in radians.
+	std::vector<float> halfWidth;		//!< half the drawn width.
+	std::vector<float> halfHeight;		//!< half the drawn height.
+	std::vector<sf::IntRect> spriteRects;	//!< rect of the atlas to draw with, such as the current animation frame.
+
+	void clear();	//!< function to remove every entry.
+	void truncate(size_t count);	//!< function to remove every entry from an index on.
+	void reserve(size_t count);	//!< function to reserve room for a number of entries.
+	size_t add(b2Body* body, const sf::Vector2f& size, const sf::IntRect& spriteRect);	//!< function to add an entry, returning its index.
+	size_t size() const { return bodies.size(); }	//!< function to return the number of entries.
+
+	void savePrevious(size_t first, size_t last);	//!< function to keep the current transforms as the previous ones, before a physics step.
+	void capture(size_t first, size_t last);		//!< function to read the body transforms, after a physics step.
+	void interpolate(size_t first, size_t last, float alpha);	//!< function to blend the render transforms between the last two steps.
+	void snap(size_t index);	//!< function to jump an entry straight to its body's transform, after a teleport.
+};
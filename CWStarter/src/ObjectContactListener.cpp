@@ -1,466 +1,182 @@
 #include "ObjectContactListener.h"
+#include <algorithm>
 
 /*!\file ObjectContactListener.cpp
 * \brief Contains all required functions for Beginning and Ending collisions.
 * As well as for Pre and Post solve functions.
-* Also function that pass values onto the game.cpp for in-game decision making.
+* Outcomes for game.cpp to act on, such as score and grounding, are raised as GameEvents.
+* Contacts are routed through a jump table keyed on both bodies' BodyTag kinds, each pair of kinds has one handler.
+* Ground and obstacles are merged outlines, so landing on them is told from the contact normal rather than from the block's position.
 */
 
-//global int initialised to 0.
-int playerScore{};
-//! Function to pass int playerScore to other class.
+const float ObjectContactListener::landingNormal = 0.7f;
+
+//! Function to push an event onto the queue Game drains after the step.
 /*!
-\param int totalScore - int that will take the passed int value of playerScore.
+\param GameEvent::Type type - what happened.
+\param BodyTag subject - the other object involved.
 */
-void ObjectContactListener::scoreCounter(int& totalScore)
+void ObjectContactListener::raise(GameEvent::Type type, BodyTag subject)
 {
-	totalScore = playerScore;
+	//the queue is sized well beyond what a step can raise, so this means the events aren't being drained.
+	if (events.push({ type, subject }) == false)
+	{
+		std::cout << "game event queue full, event dropped" << std::endl;
+	}
 }
 
-//global bool initialised to false.
-bool isGrounded{};
-//! Function to pass bool isGrounded to other class.
+//! Function to build the dispatch tables, every pair of kinds without a handler is left empty.
 /*!
-\param bool canJump - bool to take the value of isGrounded.
+\param - n/a
 */
-void ObjectContactListener::isPlayerGrounded(bool& canJump)
+ObjectContactListener::ObjectContactListener()
 {
-	canJump = isGrounded;
+	//clear both tables, a null handler means nothing happens for that pair.
+	for (int a = 0; a < BodyTag::KIND_COUNT; a++)
+	{
+		for (int b = 0; b < BodyTag::KIND_COUNT; b++)
+		{
+			beginTable[a][b] = { nullptr, false };
+			endTable[a][b] = { nullptr, false };
+			pairNames[a][b] = std::string(BodyTag::kindName(a)) + "-" + BodyTag::kindName(b);
+		}
+	}
+
+	//handlers for entering a collision.
+	addPair(beginTable, BodyTag::PLAYER, BodyTag::GROUND, &ObjectContactListener::beginPlayerGround);
+	addPair(beginTable, BodyTag::ENEMY, BodyTag::OBSTACLE, &ObjectContactListener::beginEnemyObstacle);
+	addPair(beginTable, BodyTag::ENEMY, BodyTag::ENEMY, &ObjectContactListener::beginEnemyEnemy);
+	addPair(beginTable, BodyTag::PLAYER, BodyTag::ENEMY, &ObjectContactListener::beginPlayerEnemy);
+	addPair(beginTable, BodyTag::PLAYER, BodyTag::ITEM, &ObjectContactListener::beginPlayerItem);
+	addPair(beginTable, BodyTag::PLAYER, BodyTag::OBSTACLE, &ObjectContactListener::beginPlayerObstacle);
+
+	//handlers for exiting a collision.
+	addPair(endTable, BodyTag::PLAYER, BodyTag::GROUND, &ObjectContactListener::endPlayerGround);
+	addPair(endTable, BodyTag::PLAYER, BodyTag::ENEMY, &ObjectContactListener::endPlayerEnemy);
+	addPair(endTable, BodyTag::PLAYER, BodyTag::OBSTACLE, &ObjectContactListener::endPlayerObstacle);
 }
 
-//global bool initialised to false.
-bool playerDead{};
-//! Function to pass bool playerDead to other class.
+//! Function to pass the objects stomped or collected since the last call, and start a new list.
 /*!
-\param bool isDead - bool to take the value of playerDead.
+\param std::vector removed - emptied, then given the removed objects' tags; swapped so neither list allocates once warmed up.
 */
-void ObjectContactListener::isPlayerDead(bool& isDead)
+void ObjectContactListener::collectRemovals(std::vector<BodyTag>& removed)
 {
-	isDead = playerDead;
+	removed.clear();
+	removed.swap(removals);
 }
 
-//global bools initialised to false.
-bool coinCollectSFX{};
-bool enemyHurtSFX{};
-//! Function to pass bools coinCollectSFX & enemyHurtSFX to other class for whether the relevant sound FX should be played.
+//! Function to give the listener the object lists that the body tags index into.
 /*!
-\param bool coin - bool to take the value of coinColletSFX.
-\param bool enemy - bool to take the value of enemyHurtSFX.
+\param ObjectPool ground - the ground blocks.
+\param std::vector players - the player objects.
+\param ObjectPool enemies - the enemy objects.
+\param ObjectPool items - the item objects.
+\param ObjectPool obstacles - the obstacle objects.
+\param ObjectPool sensors - the static sensors.
 */
-void ObjectContactListener::playAudio(bool& coin, bool& enemy)
+void ObjectContactListener::setObjectLists(ObjectPool<StaticRect>* ground, std::vector<Player>* players, ObjectPool<Enemy>* enemies, ObjectPool<Item>* items, ObjectPool<Obstacle>* obstacles, ObjectPool<StaticSensor>* sensors)
 {
-	coin = coinCollectSFX;
-	enemy = enemyHurtSFX;
-
-	//reset bools after use.
-	if (enemyHurtSFX == true)
-	{
-		enemyHurtSFX = false;
-	}
-	if (coinCollectSFX == true)
-	{
-		coinCollectSFX = false;
-	}
+	groundList = ground;
+	playerList = players;
+	enemyList = enemies;
+	itemList = items;
+	obstacleList = obstacles;
+	sensorList = sensors;
+
+	//at most every enemy and item can be removed in one step, so reserve that, the pools only grow a little as the level streams in.
+	removals.reserve(enemies->size() + items->size());
 }
 
-//! Function to be called on two object entering a collision.
+//! Function to register a handler for a pair of kinds, in both the (first, second) and (second, first) slots.
 /*!
-\param b2Contact contact - b2Contact class for overlapping AABB of two objects set to collide in collision filters.
+\param PairEntry table - the dispatch table to register in.
+\param BodyTag::Kind first - the kind the handler takes as its first tag.
+\param BodyTag::Kind second - the kind the handler takes as its second tag.
+\param PairHandler handler - the handler to call.
 */
-void ObjectContactListener::BeginContact(b2Contact* contact)
+void ObjectContactListener::addPair(PairEntry table[BodyTag::KIND_COUNT][BodyTag::KIND_COUNT], BodyTag::Kind first, BodyTag::Kind second, PairHandler handler)
 {
-	//setting the bodies of each contact object.
-	b2Body* bodyA = contact->GetFixtureA()->GetBody();
-	b2Body* bodyB = contact->GetFixtureB()->GetBody();
-
-	//using RTTI here to set userData to a new pair, maps a string to a void.
-	//string is the RTTI type name and void* will point to runtime variable.
-	std::pair<std::string, void *> dataA = *(std::pair<std::string, void *>*) bodyA->GetUserData();
-	std::pair<std::string, void *> dataB = *(std::pair<std::string, void *>*) bodyB->GetUserData();
+	table[first][second] = { handler, false };
+	table[second][first] = { handler, true };
+}
 
-	//bools to check whether either contact objects are sensors.
-	bool isSensorA = contact->GetFixtureA()->IsSensor();
-	bool isSensorB = contact->GetFixtureB()->IsSensor();
+//! Function to look up the handler for the kinds of both fixtures in a contact and call it, with the tags in the registered order.
+/*!
+\param PairEntry table - the dispatch table to look in.
+\param b2Contact contact - the contact to dispatch.
+*/
+void ObjectContactListener::dispatch(PairEntry table[BodyTag::KIND_COUNT][BodyTag::KIND_COUNT], b2Contact* contact)
+{
+	BodyTag tagA = BodyTag::fromFixture(contact->GetFixtureA());
+	BodyTag tagB = BodyTag::fromFixture(contact->GetFixtureB());
 
-	//checking whether either is sensor and calling action function if so.
-	if (isSensorA == true)
-	{
-		StaticSensor *sensor = static_cast <StaticSensor *> (bodyA->GetUserData());
-		sensor->action();
-		return;
-	}
-	if (isSensorB == true)
+	const PairEntry& entry = table[tagA.kind][tagB.kind];
+	if (entry.handler == nullptr)
 	{
-		StaticSensor *sensor = static_cast <StaticSensor *> (bodyB->GetUserData());
-		sensor->action();
 		return;
 	}
 
-	//PLAYER object ENTER collision with a GROUND object.
-	if (typeid(Player).name() == dataA.first)
+	if (entry.swap == true)
 	{
-		if (typeid(StaticRect).name() == dataB.first)
-		{
-			Player *player = static_cast<Player*>(dataA.second);
-			StaticRect *ground = static_cast<StaticRect*>(dataB.second);
-
-			//get y-axis positions of both player and enemy objects.
-			float playerYPos = player->getBody()->GetPosition().y;
-			float groundYPos = ground->getBody()->GetPosition().y;
-
-			//get the difference between the two positions.
-			float posDiff = ((playerYPos - groundYPos) * -1.0f);
-
-			//getting size of enemy object and a 50% of that as an offset.
-			float groundSize = ground->getGlobalBounds().height;
-			float sizeOffset = groundSize * 0.50f;
-
-			//check if posDiff bigger than groundSize & offset
-			//if so then has landed on the ground from above, so is grounded.
-			if (posDiff > (groundSize - sizeOffset))
-			{
-				if (player != nullptr)
-				{
-					//collided with ground, so isGrounded is now true.
-					isGrounded = true;
-					//need to take the impulse out of the y.axis on landing to prevent bouncying.
-					float xImpulse = player->getBody()->GetLinearVelocity().x;
-					player->getBody()->SetLinearVelocity(b2Vec2(xImpulse, 0.0f));
-				}
-			}
-			//otherwise hit ground object from the side or below.
-			else
-			{
-				if (player != nullptr)
-				{
-				}
-			}
-		}
+		(this->*entry.handler)(tagB, tagA, contact);
 	}
-	//the B-A-B of the above.
-	if (typeid(Player).name() == dataB.first)
+	else
 	{
-		if (typeid(StaticRect).name() == dataA.first)
-		{
-			Player *player = static_cast<Player*>(dataB.second);
-			StaticRect *ground = static_cast<StaticRect*>(dataA.second);
-
-			//get y-axis positions of both player and enemy objects.
-			float playerYPos = player->getBody()->GetPosition().y;
-			float groundYPos = ground->getBody()->GetPosition().y;
-
-			//get the difference between the two positions.
-			float posDiff = ((playerYPos - groundYPos) * -1.0f);
-
-			//getting size of enemy object and a 50% of that as an offset.
-			float groundSize = ground->getGlobalBounds().height;
-			float sizeOffset = groundSize * 0.50f;
-
-			//check if posDiff bigger than groundSize & offset
-			//if so then has landed on the ground from above, so is grounded.
-			if (posDiff > (groundSize - sizeOffset))
-			{
-				if (player != nullptr)
-				{
-					//collided with ground, so isGrounded is now true.
-					isGrounded = true;
-					//need to take the impulse out of the y.axis on landing to prevent bouncying.
-					float xImpulse = player->getBody()->GetLinearVelocity().x;
-					player->getBody()->SetLinearVelocity(b2Vec2(xImpulse, 0.0f));
-				}
-			}
-			//otherwise hit ground object from the side or below.
-			else
-			{
-				if (player != nullptr)
-				{
-				}
-			}
-		}
-	}
-
-	//ENEMY object ENTERS collision with OBSTACLE.
-	if (typeid(Enemy).name() == dataA.first)
-	{
-		if (typeid(Obstacle).name() == dataB.first)
-		{
-			Enemy *enemy = static_cast<Enemy*>(dataA.second);
-			if (enemy != nullptr)
-			{
-				//flip bool to say direction change required.
-				enemy->changeDirection = true;
-			}
-		}
-	}
-	//the B-A-B of the above.
-	if (typeid(Enemy).name() == dataB.first)
-	{
-		if (typeid(Obstacle).name() == dataA.first)
-		{
-			Enemy *enemy = static_cast<Enemy*>(dataB.second);
-			if (enemy != nullptr)
-			{
-				//flip bool to say direction change required.
-				enemy->changeDirection = true;
-			}
-		}
+		(this->*entry.handler)(tagA, tagB, contact);
 	}
+}
 
-	//ENEMY object ENTERS collision with another ENEMY.
-	if (typeid(Enemy).name() == dataA.first)
-	{
-		if (typeid(Enemy).name() == dataB.first)
-		{
-			Enemy *enemy1 = static_cast<Enemy*>(dataA.second);
-			Enemy *enemy2 = static_cast<Enemy*>(dataB.second);
-			if (enemy1 != nullptr)
-			{
-				//flip bool to say direction change required.
-				enemy1->changeDirection = true;
-			}
-			if (enemy2 != nullptr)
-			{
-				//flip bool to say direction change required.
-				enemy2->changeDirection = true;
-			}
-		}
-	}
-	//the B-A-B of the above.
-	if (typeid(Enemy).name() == dataB.first)
-	{
-		if (typeid(Enemy).name() == dataA.first)
-		{
-			Enemy *enemy1 = static_cast<Enemy*>(dataB.second);
-			Enemy *enemy2 = static_cast<Enemy*>(dataA.second);
-			if (enemy1 != nullptr)
-			{
-				//flip bool to say direction change required.
-				enemy1->changeDirection = true;
-			}
-			if (enemy2 != nullptr)
-			{
-				//flip bool to say direction change required.
-				enemy2->changeDirection = true;
-			}
-		}
-	}
+//! Function to return the name of the pair of kinds in a contact, in the contact's A/B order.
+/*!
+\param b2Contact contact - the contact.
+\return const char* - the pair's name, owned by the listener.
+*/
+const char* ObjectContactListener::pairName(b2Contact* contact) const
+{
+	BodyTag tagA = BodyTag::fromFixture(contact->GetFixtureA());
+	BodyTag tagB = BodyTag::fromFixture(contact->GetFixtureB());
+	return pairNames[tagA.kind][tagB.kind].c_str();
+}
 
-	//collision ENTER between PLAYER and ENEMY object.
-	if (typeid(Player).name() == dataA.first)
+//! Function to check whether either fixture in a contact is a sensor, calling the sensor's action if it is a StaticSensor.
+/*!
+\param b2Contact contact - the contact to check.
+\return bool - true if either fixture was a sensor, so the contact needs no further handling.
+*/
+bool ObjectContactListener::sensorCheck(b2Contact* contact)
+{
+	b2Fixture* fixtures[2] = { contact->GetFixtureA(), contact->GetFixtureB() };
+	for (b2Fixture* fixture : fixtures)
 	{
-		if (typeid(Enemy).name() == dataB.first)
+		if (fixture->IsSensor() == true)
 		{
-			Player *player = static_cast<Player*>(dataA.second);
-			Enemy *enemy = static_cast<Enemy*>(dataB.second);
-
-			//get y-axis positions of both player and enemy objects.
-			float playerYPos = player->getBody()->GetPosition().y;
-			float enemyYPos = enemy->getBody()->GetPosition().y;
-
-			//get the difference between the two positions.
-			float posDiff = ((playerYPos - enemyYPos) * -1.0f);
-
-			//getting size of enemy object and a 20% of that as an offset.
-			float enemySize = enemy->getGlobalBounds().height;
-			float sizeOffset = enemySize * 0.20f;
-
-			//check if posDiff bigger than enemySize & offset
-			//if so then has landed on the enemy from above, so killed it.
-			if (posDiff > (enemySize - sizeOffset))
-			{
-				if(enemy != nullptr)
-				{
-					enemy->toRemove = true;
-					enemyHurtSFX = true;
-					playerScore = playerScore + 100;
-				}
-			}
-			//otherwise the enemy has hit and killed the player.
-			else
+			BodyTag tag = BodyTag::fromFixture(fixture);
+			if (tag.kind == BodyTag::SENSOR && sensorList != nullptr)
 			{
-				if (player != nullptr)
-				{
-					playerDead = true;
-				}
+				(*sensorList)[tag.index].action();
 			}
+			return true;
 		}
 	}
-	//the B-A-B of the above.
-	if (typeid(Player).name() == dataB.first)
-	{
-		if (typeid(Enemy).name() == dataA.first)
-		{
-			Player *player = static_cast<Player*>(dataB.second);
-			Enemy *enemy = static_cast<Enemy*>(dataA.second);
-
-			//get y-axis positions of both player and enemy objects.
-			float playerYPos = player->getBody()->GetPosition().y;
-			float enemyYPos = enemy->getBody()->GetPosition().y;
-
-			//get the difference between the two positions.
-			float posDiff = ((playerYPos - enemyYPos) * -1.0f);
-
-			//getting size of enemy object and a 20% of that as an offset.
-			float enemySize = enemy->getGlobalBounds().height;
-			float sizeOffset = enemySize * 0.20f;
+	return false;
+}
 
-			//check if posDiff bigger than enemySize & offset
-			//if so then has landed on the enemy from above, so killed it.
-			if (posDiff > (enemySize - sizeOffset))
-			{
-				if (enemy != nullptr)
-				{
-					enemy->toRemove = true;
-					enemyHurtSFX = true;
-					playerScore = playerScore + 100;
-				}
-			}
-			//otherwise the enemy has hit and killed the player.
-			else
-			{
-				if (player != nullptr)
-				{
-					playerDead = true;
-				}
-			}
-		}
-	}
+//! Function to be called on two object entering a collision.
+/*!
+\param b2Contact contact - b2Contact class for overlapping AABB of two objects set to collide in collision filters.
+*/
+void ObjectContactListener::BeginContact(b2Contact* contact)
+{
+	TRACE_INSTANT("BeginContact", "contact", pairName(contact));
 
-	//ITEM ENTERS collision with PLAYER.
-	if (typeid(Item).name() == dataA.first)
+	//sensors only report the hit, they have no collision outcome.
+	if (sensorCheck(contact) == true)
 	{
-		if (typeid(Player).name() == dataB.first)
-		{
-			Item *item = static_cast<Item*>(dataA.second);
-			Player *player = static_cast<Player*>(dataB.second);
-
-			if (item != nullptr)
-			{
-				//stop forces being applied to player on contact with item.
-				player->getBody()->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
-				//increase player score.
-				playerScore = playerScore + 10;
-				//set player sound for item collection to true.
-				coinCollectSFX = true;
-				//change item.cpp bool to true.
-				item->toRemove = true;
-			}
-		}
+		return;
 	}
-	//the B-A-B of the above.
-	if (typeid(Item).name() == dataB.first)
-	{
-		if (typeid(Player).name() == dataA.first)
-		{
-			Item *item = static_cast<Item*>(dataB.second);
-			Player *player = static_cast<Player*>(dataA.second);
-
-			if (item != nullptr)
-			{
-				//stop forces being applied to player on contact with item.
-				player->getBody()->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
-				//increase player score.
-				playerScore = playerScore + 10;
-				//set player sound for item collection to true.
-				coinCollectSFX = true;
-				//change item.cpp bool to true.
-				item->toRemove = true;
-			}
-		}
-	}	
 
-	//PLAYER object ENTERS collision with a OBSTACLE object.
-	if (typeid(Player).name() == dataA.first)
-	{
-		if (typeid(Obstacle).name() == dataB.first)
-		{
-			Player *player = static_cast<Player*>(dataA.second);
-			Obstacle *obstacle = static_cast<Obstacle*>(dataB.second);
-
-			if (player != nullptr)
-			{
-				//get y-axis positions of both player and enemy objects.
-				float playerYPos = player->getBody()->GetPosition().y;
-				float obstacleYPos = obstacle->getBody()->GetPosition().y;
-
-				//get the difference between the two positions.
-				float posDiff = ((playerYPos - obstacleYPos) * -1.0f);
-
-				//getting size of enemy object and a 40% of that as an offset.
-				float obstacleSize = obstacle->getGlobalBounds().height;
-				float sizeOffset = obstacleSize * 0.40f;
-
-				//check if posDiff bigger than obstacleSize & offset
-				//if so then has landed on top of obstacle, take bounce force out and set to grounded.
-				if (posDiff > (obstacleSize - sizeOffset))
-				{
-					if (obstacle != nullptr)
-					{
-						//collided with ground, so isGrounded is now true.
-						isGrounded = true;
-						//need to take the impulse out of the y.axis on landing to prevent bouncying.
-						float xImpulse = player->getBody()->GetLinearVelocity().x;
-						player->getBody()->SetLinearVelocity(b2Vec2(xImpulse, 0.0f));
-					}
-				}
-				//otherwise hit the side, take impulse out of x-axis.
-				else
-				{
-					if (obstacle != nullptr)
-					{
-						float yImpulse = player->getBody()->GetLinearVelocity().y;
-						player->getBody()->SetLinearVelocity(b2Vec2(0.0f, yImpulse));
-					}
-				}
-			}
-		}
-	}
-	//the B-A-B of the above.
-	if (typeid(Player).name() == dataB.first)
-	{
-		if (typeid(Obstacle).name() == dataA.first)
-		{
-			Player *player = static_cast<Player*>(dataB.second);
-			Obstacle *obstacle = static_cast<Obstacle*>(dataA.second);
-
-			if (player != nullptr)
-			{
-				//get y-axis positions of both player and enemy objects.
-				float playerYPos = player->getBody()->GetPosition().y;
-				float obstacleYPos = obstacle->getBody()->GetPosition().y;
-
-				//get the difference between the two positions.
-				float posDiff = ((playerYPos - obstacleYPos) * -1.0f);
-
-				//getting size of enemy object and a 40% of that as an offset.
-				float obstacleSize = obstacle->getGlobalBounds().height;
-				float sizeOffset = obstacleSize * 0.40f;
-
-				//check if posDiff bigger than obstacleSize & offset
-				//if so then has landed on top of obstacle, take bounce force out and set to grounded.
-				if (posDiff > (obstacleSize - sizeOffset))
-				{
-					if (obstacle != nullptr)
-					{
-						//collided with ground, so isGrounded is now true.
-						isGrounded = true;
-						//need to take the impulse out of the y.axis on landing to prevent bouncying.
-						float xImpulse = player->getBody()->GetLinearVelocity().x;
-						player->getBody()->SetLinearVelocity(b2Vec2(xImpulse, 0.0f));
-					}
-				}
-				//otherwise hit the side, take impulse out of x-axis.
-				else
-				{
-					if (obstacle != nullptr)
-					{
-						float yImpulse = player->getBody()->GetLinearVelocity().y;
-						player->getBody()->SetLinearVelocity(b2Vec2(0.0f, yImpulse));
-					}
-				}
-			}
-		}
-	}
+	dispatch(beginTable, contact);
 }
 
 //! Function to be called on the exit of two objects colliding.
@@ -469,295 +185,249 @@ param b2Contact contact - b2Contact class for overlapping AABB of two objects se
 */
 void ObjectContactListener::EndContact(b2Contact* contact)
 {
-	b2Body* bodyA = contact->GetFixtureA()->GetBody();
-	b2Body* bodyB = contact->GetFixtureB()->GetBody();
-
-	std::pair<std::string, void *> dataA = *(std::pair<std::string, void *>*) bodyA->GetUserData();
-	std::pair<std::string, void *> dataB = *(std::pair<std::string, void *>*) bodyB->GetUserData();
-
-	//bools to check whether either contact objects are sensors.
-	bool isSensorA = contact->GetFixtureA()->IsSensor();
-	bool isSensorB = contact->GetFixtureB()->IsSensor();
+	TRACE_INSTANT("EndContact", "contact", pairName(contact));
 
-	//checking whether either is sensor and calling action function if so.
-	if (isSensorA == true)
+	//sensors only report the hit, they have no collision outcome.
+	if (sensorCheck(contact) == true)
 	{
-		StaticSensor *sensor = static_cast <StaticSensor *> (bodyA->GetUserData());
-		sensor->action();
 		return;
 	}
-	if (isSensorB == true)
-	{
-		StaticSensor *sensor = static_cast <StaticSensor *> (bodyB->GetUserData());
-		sensor->action();
-		return;
-	}
-
-	//PLAYER object EXITS collision with a GROUND object.
-	if (typeid(Player).name() == dataA.first)
-	{
-		if (typeid(StaticRect).name() == dataB.first)
-		{
 
-			Player *player = static_cast<Player*>(dataA.second);
-			StaticRect *ground = static_cast<StaticRect*>(dataB.second);
+	dispatch(endTable, contact);
+}
 
-			//get y-axis positions of both player and enemy objects.
-			float playerYPos = player->getBody()->GetPosition().y;
-			float groundYPos = ground->getBody()->GetPosition().y;
+void ObjectContactListener::PreSolve(b2Contact* contact)
+{
+	sensorCheck(contact);
+}
 
-			//get the difference between the two positions.
-			float posDiff = ((playerYPos - groundYPos) * -1.0f);
+void ObjectContactListener::PostSolve(b2Contact* contact)
+{
+	sensorCheck(contact);
+}
 
-			//getting size of enemy object and a 40% of that as an offset.
-			float groundSize = ground->getGlobalBounds().height;
-			float sizeOffset = groundSize * 0.40f;
+//! Function to check whether a body is on top of the other fixture in a contact, from the direction the contact pushes it.
+/*!
+\param b2Body body - the body, one of the contact's two.
+\param b2Contact contact - the contact.
+\return bool - true if the other fixture pushes the body mostly up, so it is standing on it.
+*/
+bool ObjectContactListener::isOnTop(const b2Body* body, b2Contact* contact) const
+{
+	b2WorldManifold manifold;
+	contact->GetWorldManifold(&manifold);
 
-			//check if posDiff bigger than groundSize & offset
-			//if so then has landed on the ground from above, so is grounded.
-			if (posDiff > (groundSize - sizeOffset))
-			{
-				if (player != nullptr)
-				{
-					//exited contact with ground, so no longer isGrounded.
-					isGrounded = false;
-				}
-			}
-			else
-			{
-				if (player != nullptr)
-				{
-				}
-			}
-		}
-	}
-	//the B-A-B of the above.
-	if (typeid(Player).name() == dataB.first)
+	//the normal points from fixture A to fixture B, flipped if need be to point from the surface to the body.
+	float normalY = manifold.normal.y;
+	if (contact->GetFixtureA()->GetBody() == body)
 	{
-		if (typeid(StaticRect).name() == dataA.first)
-		{
-
-			Player *player = static_cast<Player*>(dataB.second);
-			StaticRect *ground = static_cast<StaticRect*>(dataA.second);
-
-			//get y-axis positions of both player and enemy objects.
-			float playerYPos = player->getBody()->GetPosition().y;
-			float groundYPos = ground->getBody()->GetPosition().y;
-
-			//get the difference between the two positions.
-			float posDiff = ((playerYPos - groundYPos) * -1.0f);
-
-			//getting size of enemy object and a 40% of that as an offset.
-			float groundSize = ground->getGlobalBounds().height;
-			float sizeOffset = groundSize * 0.40f;
-
-			//check if posDiff bigger than groundSize & offset
-			//if so then has landed on the ground from above, so is grounded.
-			if (posDiff > (groundSize - sizeOffset))
-			{
-				if (player != nullptr)
-				{
-					//exited contact with ground, so no longer isGrounded.
-					isGrounded = false;
-				}
-			}
-			//otherwise hit ground from side.
-			else
-			{
-				if (player != nullptr)
-				{
-				}
-			}
-		}
+		normalY = -normalY;
 	}
+	//up is -y.
+	return normalY < -landingNormal;
+}
 
+//! Function to ground a player that has landed on a surface, remembering the contact so the player is only ungrounded once off every surface.
+/*!
+\param BodyTag playerTag - tag of the player.
+\param BodyTag surfaceTag - tag of the block or obstacle landed on.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::land(BodyTag playerTag, BodyTag surfaceTag, b2Contact* contact)
+{
+	Player* player = &(*playerList)[playerTag.index];
 
-	//collision EXIT between PLAYER and ENEMY object.
-	if (typeid(Player).name() == dataA.first)
-	{
-		if (typeid(Enemy).name() == dataB.first)
-		{
-			Player *player = static_cast<Player*>(dataA.second);
-			Enemy *enemy = static_cast<Enemy*>(dataB.second);
-			if (player != nullptr) 
-			{
-				playerDead = false;
-			}
-		}
-	}
-	//the B-A-B of the above.
-	if (typeid(Player).name() == dataB.first)
+	groundedContacts.push_back(std::make_pair(contact, playerTag.index));
+	raise(GameEvent::GROUNDED, surfaceTag);
+	//need to take the impulse out of the y.axis on landing to prevent bouncying.
+	float xImpulse = player->getBody()->GetLinearVelocity().x;
+	player->getBody()->SetLinearVelocity(b2Vec2(xImpulse, 0.0f));
+}
+
+//! Function to forget a contact a player stood on, ungrounding the player if it was the last surface it was standing on.
+/*!
+\param BodyTag playerTag - tag of the player.
+\param BodyTag surfaceTag - tag of the block or obstacle left.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::leave(BodyTag playerTag, BodyTag surfaceTag, b2Contact* contact)
+{
+	auto grounded = std::find(groundedContacts.begin(), groundedContacts.end(), std::make_pair(contact, playerTag.index));
+	if (grounded == groundedContacts.end())
 	{
-		if (typeid(Enemy).name() == dataA.first)
-		{
-			Player *player = static_cast<Player*>(dataB.second);
-			Enemy *enemy = static_cast<Enemy*>(dataA.second);
-			if (player != nullptr)
-			{
-				playerDead = false;
-			}
-		}
+		return;
 	}
+	groundedContacts.erase(grounded);
 
-	//ITEM EXITS collision with PLAYER.
-	if (typeid(Item).name() == dataA.first)
+	for (const std::pair<b2Contact*, uint16>& other : groundedContacts)
 	{
-		if (typeid(Player).name() == dataB.first)
+		if (other.second == playerTag.index)
 		{
-			Item *item = static_cast<Item*>(dataA.second);
-			if (item != nullptr)
-			{
-				//
-			}
+			return;
 		}
 	}
-	//the B-A-B of the above.
-	if (typeid(Item).name() == dataB.first)
+	//off every surface, so no longer grounded.
+	raise(GameEvent::UNGROUNDED, surfaceTag);
+}
+
+//! PLAYER object ENTERS collision with a GROUND object.
+/*!
+\param BodyTag playerTag - tag of the player.
+\param BodyTag groundTag - tag of the ground block.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::beginPlayerGround(BodyTag playerTag, BodyTag groundTag, b2Contact* contact)
+{
+	//only landing on top grounds the player, not brushing the side or bumping the underneath.
+	if (isOnTop((*playerList)[playerTag.index].getBody(), contact) == true)
 	{
-		if (typeid(Player).name() == dataA.first)
-		{
-			Item *item = static_cast<Item*>(dataB.second);
-			if (item != nullptr)
-			{
-				//
-			}
-		}
+		land(playerTag, groundTag, contact);
 	}
+}
 
-	//PLAYER object EXITS collision with a OBSTACLE object.
-	if (typeid(Player).name() == dataA.first)
-	{
-		if (typeid(Obstacle).name() == dataB.first)
-		{
-			Player *player = static_cast<Player*>(dataA.second);
-			Obstacle *obstacle = static_cast<Obstacle*>(dataB.second);
+//! PLAYER object EXITS collision with a GROUND object.
+/*!
+\param BodyTag playerTag - tag of the player.
+\param BodyTag groundTag - tag of the ground block.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::endPlayerGround(BodyTag playerTag, BodyTag groundTag, b2Contact* contact)
+{
+	leave(playerTag, groundTag, contact);
+}
 
-			if (player != nullptr)
-			{
-				//get y-axis positions of both player and enemy objects.
-				float playerYPos = player->getBody()->GetPosition().y;
-				float obstacleYPos = obstacle->getBody()->GetPosition().y;
-
-				//get the difference between the two positions.
-				float posDiff = ((playerYPos - obstacleYPos) * -1.0f);
-
-				//getting size of enemy object and a 40% of that as an offset.
-				float obstacleSize = obstacle->getGlobalBounds().height;
-				float sizeOffset = obstacleSize * 0.40f;
-
-				//check if posDiff bigger than obstacle size & offset
-				//so on top of obstacle and jumping off.
-				if (posDiff > (obstacleSize - sizeOffset))
-				{
-					if (obstacle != nullptr)
-					{
-						//jumping off top of obstacle
-						isGrounded = false;
-					}
-				}
-				else
-				{
-					if (obstacle != nullptr)
-					{
-					}
-				}
-			}
-		}
-	}
-	//the B-A-B of the above.
-	if (typeid(Player).name() == dataB.first)
-	{
-		if (typeid(Obstacle).name() == dataA.first)
-		{
-			Player *player = static_cast<Player*>(dataB.second);
-			Obstacle *obstacle = static_cast<Obstacle*>(dataA.second);
+//! ENEMY object ENTERS collision with OBSTACLE.
+/*!
+\param BodyTag enemyTag - tag of the enemy.
+\param BodyTag obstacleTag - tag of the obstacle.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::beginEnemyObstacle(BodyTag enemyTag, BodyTag, b2Contact*)
+{
+	//flip bool to say direction change required.
+	(*enemyList)[enemyTag.index].changeDirection = true;
+}
 
-			if (player != nullptr)
-			{
-				//get y-axis positions of both player and enemy objects.
-				float playerYPos = player->getBody()->GetPosition().y;
-				float obstacleYPos = obstacle->getBody()->GetPosition().y;
-
-				//get the difference between the two positions.
-				float posDiff = ((playerYPos - obstacleYPos) * -1.0f);
-
-				//getting size of enemy object and a 40% of that as an offset.
-				float obstacleSize = obstacle->getGlobalBounds().height;
-				float sizeOffset = obstacleSize * 0.40f;
-
-				//check if posDiff bigger than obstacle size & offset
-				//so on top of obstacle and jumping off.
-				if (posDiff > (obstacleSize - sizeOffset))
-				{
-					if (obstacle != nullptr)
-					{
-						//jumping off top of obstacle
-						isGrounded = false;
-					}
-				}
-				else
-				{
-					if (obstacle != nullptr)
-					{
-					}
-				}
-			}
-		}
-	}
+//! ENEMY object ENTERS collision with another ENEMY.
+/*!
+\param BodyTag enemyTag1 - tag of the first enemy.
+\param BodyTag enemyTag2 - tag of the second enemy.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::beginEnemyEnemy(BodyTag enemyTag1, BodyTag enemyTag2, b2Contact*)
+{
+	//flip bools to say direction change required, for both.
+	(*enemyList)[enemyTag1.index].changeDirection = true;
+	(*enemyList)[enemyTag2.index].changeDirection = true;
 }
 
-void ObjectContactListener::PreSolve(b2Contact* contact)
+//! collision ENTER between PLAYER and ENEMY object.
+/*!
+\param BodyTag playerTag - tag of the player.
+\param BodyTag enemyTag - tag of the enemy.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::beginPlayerEnemy(BodyTag playerTag, BodyTag enemyTag, b2Contact*)
 {
-	b2Body* bodyA = contact->GetFixtureA()->GetBody();
-	b2Body* bodyB = contact->GetFixtureB()->GetBody();
+	Player* player = &(*playerList)[playerTag.index];
+	Enemy* enemy = &(*enemyList)[enemyTag.index];
 
-	std::pair<std::string, void *> dataA = *(std::pair<std::string, void *>*) bodyA->GetUserData();
-	std::pair<std::string, void *> dataB = *(std::pair<std::string, void *>*) bodyB->GetUserData();
+	//get y-axis positions of both player and enemy objects.
+	float playerYPos = player->getBody()->GetPosition().y;
+	float enemyYPos = enemy->getBody()->GetPosition().y;
 
-	//bools to check whether either contact objects are sensors.
-	bool isSensorA = contact->GetFixtureA()->IsSensor();
-	bool isSensorB = contact->GetFixtureB()->IsSensor();
+	//get the difference between the two positions.
+	float posDiff = ((playerYPos - enemyYPos) * -1.0f);
 
-	//checking whether either is sensor and calling action function if so.
-	if (isSensorA == true)
+	//getting size of enemy object and a 20% of that as an offset.
+	float enemySize = enemy->getGlobalBounds().height;
+	float sizeOffset = enemySize * 0.20f;
+
+	//check if posDiff bigger than enemySize & offset
+	//if so then has landed on the enemy from above, so killed it.
+	if (posDiff > (enemySize - sizeOffset))
 	{
-		StaticSensor *sensor = static_cast <StaticSensor *> (bodyA->GetUserData());
-		sensor->action();
-		return;
+		//only record and score it once, it can begin touching the player again before Game releases it after the step.
+		if (enemy->toRemove == false)
+		{
+			removals.push_back(enemyTag);
+			//scores and plays the stomp sound.
+			raise(GameEvent::ENEMY_STOMPED, enemyTag);
+		}
+		enemy->toRemove = true;
 	}
-	if (isSensorB == true)
+	//otherwise the enemy has hit and killed the player.
+	else
 	{
-		StaticSensor *sensor = static_cast <StaticSensor *> (bodyB->GetUserData());
-		sensor->action();
-		return;
+		raise(GameEvent::PLAYER_HIT, enemyTag);
 	}
+}
 
+//! collision EXIT between PLAYER and ENEMY object.
+/*!
+\param BodyTag playerTag - tag of the player.
+\param BodyTag enemyTag - tag of the enemy.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::endPlayerEnemy(BodyTag, BodyTag enemyTag, b2Contact*)
+{
+	raise(GameEvent::PLAYER_HIT_ENDED, enemyTag);
 }
 
-void ObjectContactListener::PostSolve(b2Contact* contact)
+//! ITEM ENTERS collision with PLAYER.
+/*!
+\param BodyTag playerTag - tag of the player.
+\param BodyTag itemTag - tag of the item.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::beginPlayerItem(BodyTag playerTag, BodyTag itemTag, b2Contact*)
 {
-	b2Body* bodyA = contact->GetFixtureA()->GetBody();
-	b2Body* bodyB = contact->GetFixtureB()->GetBody();
+	Player* player = &(*playerList)[playerTag.index];
+	Item* item = &(*itemList)[itemTag.index];
 
-	std::pair<std::string, void *> dataA = *(std::pair<std::string, void *>*) bodyA->GetUserData();
-	std::pair<std::string, void *> dataB = *(std::pair<std::string, void *>*) bodyB->GetUserData();
+	//stop forces being applied to player on contact with item.
+	player->getBody()->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+	//change item.cpp bool to true, and record it for Game to release once, after the step.
+	if (item->toRemove == false)
+	{
+		removals.push_back(itemTag);
+		//increase player score and play the collection sound.
+		raise(GameEvent::COIN_COLLECTED, itemTag);
+	}
+	item->toRemove = true;
+}
 
-	//bools to check whether either contact objects are sensors.
-	bool isSensorA = contact->GetFixtureA()->IsSensor();
-	bool isSensorB = contact->GetFixtureB()->IsSensor();
+//! PLAYER object ENTERS collision with a OBSTACLE object.
+/*!
+\param BodyTag playerTag - tag of the player.
+\param BodyTag obstacleTag - tag of the obstacle.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::beginPlayerObstacle(BodyTag playerTag, BodyTag obstacleTag, b2Contact* contact)
+{
+	Player* player = &(*playerList)[playerTag.index];
 
-	//checking whether either is sensor and calling action function if so.
-	if (isSensorA == true)
+	//landed on top, so is now grounded.
+	if (isOnTop(player->getBody(), contact) == true)
 	{
-		StaticSensor *sensor = static_cast <StaticSensor *> (bodyA->GetUserData());
-		sensor->action();
-		return;
+		land(playerTag, obstacleTag, contact);
 	}
-	if (isSensorB == true)
+	//otherwise hit the side, take impulse out of x-axis.
+	else
 	{
-		StaticSensor *sensor = static_cast <StaticSensor *> (bodyB->GetUserData());
-		sensor->action();
-		return;
+		float yImpulse = player->getBody()->GetLinearVelocity().y;
+		player->getBody()->SetLinearVelocity(b2Vec2(0.0f, yImpulse));
 	}
+}
 
-}
\ No newline at end of file
+//! PLAYER object EXITS collision with a OBSTACLE object.
+/*!
+\param BodyTag playerTag - tag of the player.
+\param BodyTag obstacleTag - tag of the obstacle.
+\param b2Contact contact - the contact between them.
+*/
+void ObjectContactListener::endPlayerObstacle(BodyTag playerTag, BodyTag obstacleTag, b2Contact* contact)
+{
+	//jumping or walking off the top of the obstacle.
+	leave(playerTag, obstacleTag, contact);
+}
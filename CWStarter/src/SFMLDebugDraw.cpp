@@ -1,97 +1,264 @@
 #include "SFMLDebugDraw.h"
+#include <algorithm>
+#include <cmath>
+
+/*! \file SFMLDebugDraw.cpp
+* \brief Contains functions to debug draw the Box2D world into two reused vertex arrays, culled to the view.
+*/
+
+static const float fillShade = 0.5f;		//!< filled shapes are this much darker than their outline, and half see through.
+static const float pointScale = 0.0125f;	//!< metres a point is drawn across for each unit of Box2D's point size.
+static const float axisScale = 0.4f;		//!< length of the axes DrawTransform draws.
+static const float normalScale = 0.3f;		//!< length of the contact normals drawn.
+static const float circleStep = 2.0f * b2_pi / DebugDraw::circleSegments;	//!< angle between circle vertices.
+
+//turns a Box2D colour, 0 to 1 a channel, into an SFML one.
+static sf::Color toColour(const b2Color& color, float shade = 1.0f, float alpha = 1.0f) {
+	return sf::Color((sf::Uint8)(color.r * shade * 255.0f), (sf::Uint8)(color.g * shade * 255.0f), (sf::Uint8)(color.b * shade * 255.0f), (sf::Uint8)(alpha * 255.0f));
+}
 
 void SFMLDebugDraw::setWorld(b2World * world) {
 	m_pWorld = world;
 	m_pWorld->SetDebugDraw(&m_debugDraw);
 	m_debugDraw.SetFlags(b2Draw::e_shapeBit);
 }
+
+void SFMLDebugDraw::toggleFlag(uint32 flag) {
+	if ((m_debugDraw.GetFlags() & flag) != 0)
+		m_debugDraw.ClearFlags(flag);
+	else
+		m_debugDraw.AppendFlags(flag);
+}
+
+//rebuilds the debug shapes of everything overlapping the target's view, then draws all the triangles and all the lines in one call each.
 void SFMLDebugDraw::draw(sf::RenderTarget &target, sf::RenderStates states) const {
-	m_pWorld->DrawDebugData();
-	std::vector<sf::VertexArray> shapes = m_debugDraw.getShapes();
-	for (auto shape : shapes)
+	m_debugDraw.clearShapes();
+	uint32 flags = m_debugDraw.GetFlags();
+
+	//the view's bounds in world co-ords.
+	const sf::View& view = target.getView();
+	b2AABB bounds;
+	bounds.lowerBound.Set(view.getCenter().x - view.getSize().x * 0.5f, view.getCenter().y - view.getSize().y * 0.5f);
+	bounds.upperBound.Set(view.getCenter().x + view.getSize().x * 0.5f, view.getCenter().y + view.getSize().y * 0.5f);
+
+	//a fixture is reported once for each of its proxies in view, a chain once an edge, so sort out the repeats.
+	m_query.fixtures.clear();
+	m_pWorld->QueryAABB(&m_query, bounds);
+	std::sort(m_query.fixtures.begin(), m_query.fixtures.end());
+	m_query.fixtures.erase(std::unique(m_query.fixtures.begin(), m_query.fixtures.end()), m_query.fixtures.end());
+
+	if ((flags & b2Draw::e_shapeBit) != 0)
+	{
+		for (const b2Fixture* fixture : m_query.fixtures)
+			drawFixture(fixture, bounds);
+	}
+
+	if ((flags & b2Draw::e_aabbBit) != 0)
+	{
+		//the broadphase's fattened AABBs, one for each child.
+		b2Color color(0.9f, 0.3f, 0.9f);
+		for (const b2Fixture* fixture : m_query.fixtures)
+		{
+			for (int32 child = 0; child < fixture->GetShape()->GetChildCount(); child++)
+			{
+				const b2AABB& aabb = fixture->GetAABB(child);
+				if (!b2TestOverlap(aabb, bounds))
+					continue;
+				b2Vec2 corners[4] = { aabb.lowerBound, b2Vec2(aabb.upperBound.x, aabb.lowerBound.y), aabb.upperBound, b2Vec2(aabb.lowerBound.x, aabb.upperBound.y) };
+				m_debugDraw.DrawPolygon(corners, 4, color);
+			}
+		}
+	}
+
+	if ((flags & b2Draw::e_centerOfMassBit) != 0)
+	{
+		m_query.bodies.clear();
+		for (b2Fixture* fixture : m_query.fixtures)
+			m_query.bodies.push_back(fixture->GetBody());
+		std::sort(m_query.bodies.begin(), m_query.bodies.end());
+		m_query.bodies.erase(std::unique(m_query.bodies.begin(), m_query.bodies.end()), m_query.bodies.end());
+		for (const b2Body* body : m_query.bodies)
+		{
+			b2Transform xf = body->GetTransform();
+			xf.p = body->GetWorldCenter();
+			m_debugDraw.DrawTransform(xf);
+		}
+	}
+
+	if ((flags & b2Draw::e_jointBit) != 0)
+	{
+		//each joint from its bodies to its anchors, those with either anchor in view.
+		b2Color color(0.5f, 0.8f, 0.8f);
+		for (b2Joint* joint = m_pWorld->GetJointList(); joint != nullptr; joint = joint->GetNext())
+		{
+			b2Vec2 anchorA = joint->GetAnchorA();
+			b2Vec2 anchorB = joint->GetAnchorB();
+			b2AABB extent;
+			extent.lowerBound.Set(std::min(anchorA.x, anchorB.x), std::min(anchorA.y, anchorB.y));
+			extent.upperBound.Set(std::max(anchorA.x, anchorB.x), std::max(anchorA.y, anchorB.y));
+			if (!b2TestOverlap(extent, bounds))
+				continue;
+			m_debugDraw.DrawSegment(joint->GetBodyA()->GetPosition(), anchorA, color);
+			m_debugDraw.DrawSegment(anchorA, anchorB, color);
+			m_debugDraw.DrawSegment(joint->GetBodyB()->GetPosition(), anchorB, color);
+		}
+	}
+
+	if ((flags & b2Draw::e_pairBit) != 0)
 	{
-		target.draw(shape);
+		//each touching contact's points, with its normal from A to B.
+		b2Color pointColor(0.9f, 0.9f, 0.3f);
+		b2Color normalColor(0.3f, 0.9f, 0.3f);
+		for (b2Contact* contact = m_pWorld->GetContactList(); contact != nullptr; contact = contact->GetNext())
+		{
+			if (!contact->IsTouching())
+				continue;
+			b2WorldManifold manifold;
+			contact->GetWorldManifold(&manifold);
+			for (int32 i = 0; i < contact->GetManifold()->pointCount; i++)
+			{
+				const b2Vec2& point = manifold.points[i];
+				if (point.x < bounds.lowerBound.x || point.x > bounds.upperBound.x || point.y < bounds.lowerBound.y || point.y > bounds.upperBound.y)
+					continue;
+				m_debugDraw.DrawPoint(point, 4.0f, pointColor);
+				m_debugDraw.DrawSegment(point, point + normalScale * manifold.normal, normalColor);
+			}
+		}
 	}
+
+	target.draw(m_debugDraw.getTriangles(), states);
+	target.draw(m_debugDraw.getLines(), states);
 };
 
-void SFMLDebugDraw::clear() { m_debugDraw.clearShapes(); }
+//draws a fixture's shape in the colour b2World::DrawDebugData would, by its body's type and state.
+void SFMLDebugDraw::drawFixture(const b2Fixture* fixture, const b2AABB& bounds) const {
+	const b2Body* body = fixture->GetBody();
+	const b2Transform& xf = body->GetTransform();
+	b2Color color(0.9f, 0.7f, 0.7f);
+	if (body->GetType() == b2_staticBody)
+		color = b2Color(0.5f, 0.9f, 0.5f);
+	else if (body->GetType() == b2_kinematicBody)
+		color = b2Color(0.5f, 0.5f, 0.9f);
+	else if (!body->IsAwake())
+		color = b2Color(0.6f, 0.6f, 0.6f);
+
+	switch (fixture->GetType())
+	{
+	case b2Shape::e_circle:
+	{
+		const b2CircleShape* circle = (const b2CircleShape*)fixture->GetShape();
+		m_debugDraw.DrawSolidCircle(b2Mul(xf, circle->m_p), circle->m_radius, xf.q.GetXAxis(), color);
+		break;
+	}
+	case b2Shape::e_edge:
+	{
+		const b2EdgeShape* edge = (const b2EdgeShape*)fixture->GetShape();
+		m_debugDraw.DrawSegment(b2Mul(xf, edge->m_vertex1), b2Mul(xf, edge->m_vertex2), color);
+		break;
+	}
+	case b2Shape::e_chain:
+	{
+		//merged outlines can run the length of a chunk, only their edges in view are drawn.
+		const b2ChainShape* chain = (const b2ChainShape*)fixture->GetShape();
+		for (int32 child = 0; child < chain->GetChildCount(); child++)
+		{
+			if (b2TestOverlap(fixture->GetAABB(child), bounds))
+				m_debugDraw.DrawSegment(b2Mul(xf, chain->m_vertices[child]), b2Mul(xf, chain->m_vertices[child + 1]), color);
+		}
+		break;
+	}
+	case b2Shape::e_polygon:
+	{
+		const b2PolygonShape* polygon = (const b2PolygonShape*)fixture->GetShape();
+		b2Vec2 vertices[b2_maxPolygonVertices];
+		for (int32 i = 0; i < polygon->m_count; i++)
+			vertices[i] = b2Mul(xf, polygon->m_vertices[i]);
+		m_debugDraw.DrawSolidPolygon(vertices, polygon->m_count, color);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+void DebugDraw::clearShapes() {
+	m_lines.clear();
+	m_triangles.clear();
+}
+
+void DebugDraw::addLine(const b2Vec2& p1, const b2Vec2& p2, const sf::Color& colour) {
+	m_lines.append(sf::Vertex(sf::Vector2f(p1.x, p1.y), colour));
+	m_lines.append(sf::Vertex(sf::Vector2f(p2.x, p2.y), colour));
+}
+
+void DebugDraw::addTriangle(const b2Vec2& p1, const b2Vec2& p2, const b2Vec2& p3, const sf::Color& colour) {
+	m_triangles.append(sf::Vertex(sf::Vector2f(p1.x, p1.y), colour));
+	m_triangles.append(sf::Vertex(sf::Vector2f(p2.x, p2.y), colour));
+	m_triangles.append(sf::Vertex(sf::Vector2f(p3.x, p3.y), colour));
+}
 
 void DebugDraw::DrawPoint(const b2Vec2& p, float32 size, const b2Color& color) {
-	sf::VertexArray va(sf::Points, 1);
-	va[0] = sf::Vertex(sf::Vector2f(p.x, p.y), sf::Color(color.r, color.g, color.b));
-	m_shapes.push_back(va);
+	//a small square, two triangles.
+	float half = size * pointScale * 0.5f;
+	sf::Color colour = toColour(color);
+	b2Vec2 topLeft(p.x - half, p.y - half);
+	b2Vec2 topRight(p.x + half, p.y - half);
+	b2Vec2 bottomRight(p.x + half, p.y + half);
+	b2Vec2 bottomLeft(p.x - half, p.y + half);
+	addTriangle(topLeft, topRight, bottomRight, colour);
+	addTriangle(topLeft, bottomRight, bottomLeft, colour);
 };
 
 void DebugDraw::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) {
-	sf::VertexArray va(sf::Quads, vertexCount);
-
-	for (int i = 0; i < vertexCount; i++)
+	//Box2D polygons are convex, so a fan from the first vertex fills them.
+	sf::Color fill = toColour(color, fillShade, fillShade);
+	for (int i = 1; i + 1 < vertexCount; i++)
 	{
-		va[i] = sf::Vertex(sf::Vector2f(vertices[i].x, vertices[i].y), sf::Color(color.r, color.g, color.b));
+		addTriangle(vertices[0], vertices[i], vertices[i + 1], fill);
 	}
-	m_shapes.push_back(va);
+	DrawPolygon(vertices, vertexCount, color);
 };
 
 void DebugDraw::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) {
-	sf::VertexArray va(sf::LineStrip, vertexCount + 1);
-
+	sf::Color colour = toColour(color);
 	for (int i = 0; i < vertexCount; i++)
 	{
-		va[i] = sf::Vertex(sf::Vector2f(vertices[i].x, vertices[i].y), sf::Color(color.r, color.g, color.b));
+		addLine(vertices[i], vertices[(i + 1) % vertexCount], colour);
 	}
-	va[vertexCount] = va[0];
-	m_shapes.push_back(va);
 };
 
 void DebugDraw::DrawCircle(const b2Vec2& center, float32 radius, const b2Color& color) {
-	float vertexCount = 30.f;
-	sf::VertexArray va(sf::LinesStrip, vertexCount);
-	float thetaStep = (2.f * 3.15f) / (vertexCount - 1.f);
-	float theta = 0;
-	sf::Vector2f point;
-
-	for (int i = 0; i < vertexCount; i++)
+	sf::Color colour = toColour(color);
+	b2Vec2 last(center.x + radius, center.y);
+	for (int i = 1; i <= circleSegments; i++)
 	{
-		point.x = center.x + cos(theta) * radius;
-		point.y = center.y + sin(theta) * radius;
-		va[i] = sf::Vertex(point, sf::Color(color.r, color.g, color.b));
-		theta += thetaStep;
+		b2Vec2 point(center.x + std::cos(circleStep * i) * radius, center.y + std::sin(circleStep * i) * radius);
+		addLine(last, point, colour);
+		last = point;
 	}
-	m_shapes.push_back(va);
 };
 
 void DebugDraw::DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& color) {
-	float vertexCount = 31.f;
-	sf::VertexArray va(sf::TriangleFan, vertexCount);
-	float thetaStep = (2.f * 3.15f) / (vertexCount - 2.f);
-	float theta = 0;
-	sf::Vector2f point;
-
-	va[0] = sf::Vertex(sf::Vector2f(center.x, center.y), sf::Color(color.r, color.g, color.b));
-	for (int i = 1; i < vertexCount; i++)
+	sf::Color fill = toColour(color, fillShade, fillShade);
+	b2Vec2 last(center.x + radius, center.y);
+	for (int i = 1; i <= circleSegments; i++)
 	{
-		point.x = center.x + cos(theta) * radius;
-		point.y = center.y + sin(theta) * radius;
-		va[i] = sf::Vertex(point, sf::Color(color.r, color.g, color.b));
-		theta += thetaStep;
+		b2Vec2 point(center.x + std::cos(circleStep * i) * radius, center.y + std::sin(circleStep * i) * radius);
+		addTriangle(center, last, point, fill);
+		last = point;
 	}
-	m_shapes.push_back(va);
-
-	sf::VertexArray va2(sf::Lines, 2);
-	va2[0] = sf::Vertex(sf::Vector2f(center.x, center.y), sf::Color(255, 0, 0));
-	point.x = center.x + axis.x * radius;
-	point.y = center.y + axis.y * radius;
-	va2[1] = sf::Vertex(point, sf::Color(255, 0, 0));
-	m_shapes.push_back(va2);
+	DrawCircle(center, radius, color);
+
+	//the axis shows which way the circle has rolled.
+	addLine(center, center + radius * axis, toColour(color));
 };
 
 void DebugDraw::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) {
-	sf::VertexArray va(sf::Lines, 2);
-	va[0] = sf::Vertex(sf::Vector2f(p1.x, p1.y), sf::Color(color.r, color.g, color.b));
-	va[1] = sf::Vertex(sf::Vector2f(p2.x, p2.y), sf::Color(color.r, color.g, color.b));
-	m_shapes.push_back(va);
+	addLine(p1, p2, toColour(color));
 };
 
 void DebugDraw::DrawTransform(const b2Transform& xf) {
-	// Sorry, not sure how to do this?
-};
\ No newline at end of file
+	//the x axis in red and the y axis in green, from the transform's position.
+	addLine(xf.p, xf.p + axisScale * xf.q.GetXAxis(), sf::Color(255, 0, 0));
+	addLine(xf.p, xf.p + axisScale * xf.q.GetYAxis(), sf::Color(0, 255, 0));
+};
@@ -0,0 +1,125 @@
+#include "assetLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include "tracer.h"
+
+/*! \file assetLoader.cpp
+* \brief Contains functions to decode assets on worker threads and finish them on the main thread in small batches.
+*/
+
+//! Function to stop the workers and wait for them, so none outlives the memory it decodes into.
+/*!
+\param - n/a
+*/
+AssetLoader::~AssetLoader()
+{
+	stop();
+}
+
+//! Function to add an asset to load, in the order it should be finished.
+/*!
+\param std::string name - what is being loaded, printed if it fails.
+\param Decode decode - reads and decodes the asset, run on a worker thread.
+\param Finish finish - uploads or hands over the decoded asset, run on the main thread.
+*/
+void AssetLoader::add(const std::string& name, Decode decode, Finish finish)
+{
+	std::unique_ptr<Job> job(new Job());
+	job->name = name;
+	job->decode = decode;
+	job->finish = finish;
+	job->result = job->promise.get_future();
+	jobs.push_back(std::move(job));
+}
+
+//! Function run on each worker thread, taking the next job off a shared counter until none are left.
+/*!
+\param - n/a
+*/
+void AssetLoader::work()
+{
+	for (size_t i = nextDecode++; i < jobs.size() && !stopping; i = nextDecode++)
+	{
+		Job& job = *jobs[i];
+		TRACE_SCOPE(job.name.c_str(), "decode");
+		job.promise.set_value(job.decode());
+	}
+}
+
+//! Function to start decoding every asset added, on worker threads.
+/*!
+\param unsigned threadCount - workers to use, no more than there are assets.
+*/
+void AssetLoader::start(unsigned threadCount)
+{
+	threadCount = std::min(threadCount, (unsigned)jobs.size());
+	for (unsigned i = 0; i < threadCount; i++)
+	{
+		workers.emplace_back(&AssetLoader::work, this);
+	}
+}
+
+//! Function to decode then finish every asset on the calling thread, for the headless build where there is no frame to spread them over.
+/*!
+\param - n/a
+*/
+void AssetLoader::loadNow()
+{
+	work();
+	finish((int)jobs.size());
+}
+
+//! Function to finish assets whose decode is done, in order, stopping at the first still decoding.
+/*!
+\param int maxJobs - most assets to finish, to keep the uploads from stalling a frame.
+\return bool - whether every asset is now finished.
+*/
+bool AssetLoader::finish(int maxJobs)
+{
+	for (int finished = 0; finished < maxJobs && nextFinish < jobs.size(); finished++)
+	{
+		Job& job = *jobs[nextFinish];
+		if (job.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			break;
+		}
+
+		//a failed decode is finished all the same, with a placeholder in its place.
+		bool decoded = job.result.get();
+		if (decoded == false)
+		{
+			std::cout << "Error loading " << job.name << ", using a placeholder" << std::endl;
+			failures++;
+		}
+		{
+			TRACE_SCOPE(job.name.c_str(), "upload");
+			job.finish(decoded);
+		}
+		//let go of whatever the halves held, such as a decoded image, now it has been handed over.
+		job.decode = nullptr;
+		job.finish = nullptr;
+		nextFinish++;
+	}
+
+	//the workers are done with once everything is finished.
+	if (isFinished() == true)
+	{
+		stop();
+	}
+	return isFinished();
+}
+
+//! Function to stop the workers taking more jobs, and wait for those running to finish.
+/*!
+\param - n/a
+*/
+void AssetLoader::stop()
+{
+	stopping = true;
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+	workers.clear();
+}
@@ -0,0 +1,39 @@
+#include "assetRegistry.h"
+
+/*! \file assetRegistry.cpp
+* \brief Contains the process wide asset table and its upkeep.
+*/
+
+std::mutex AssetRegistry::mutex;
+std::map<std::string, std::weak_ptr<const void>> AssetRegistry::assets;
+
+//! Function to drop the entries whose last user has gone, so the table only grows with what is loaded at once.
+/*!
+\param - n/a
+*/
+void AssetRegistry::prune()
+{
+	for (auto entry = assets.begin(); entry != assets.end();)
+	{
+		if (entry->second.expired())
+		{
+			entry = assets.erase(entry);
+		}
+		else
+		{
+			entry++;
+		}
+	}
+}
+
+//! Function to return how many assets are loaded and still in use by at least one Game.
+/*!
+\param - n/a
+\return size_t - the count.
+*/
+size_t AssetRegistry::getCount()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	prune();
+	return assets.size();
+}
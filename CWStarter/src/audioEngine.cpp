@@ -0,0 +1,150 @@
+#include "audioEngine.h"
+
+/*! \file audioEngine.cpp
+* \brief Contains functions for the audio thread, its command queue and its pool of voices.
+* Not built into the headless build, which has the stand-in in audioEngine.h.
+*/
+
+#ifndef HEADLESS
+#include <chrono>
+
+std::mutex AudioEngine::attachMutex;
+
+//! Function to start the audio thread, the voices are made here on the game thread but only used on the audio thread.
+/*!
+\param - n/a
+*/
+AudioEngine::AudioEngine()
+{
+	thread = std::thread(&AudioEngine::run, this);
+}
+
+//! Function to stop the audio thread, then detach the voices from buffers another Game may still be playing.
+/*!
+\param - n/a
+*/
+AudioEngine::~AudioEngine()
+{
+	running = false;
+	thread.join();
+
+	std::lock_guard<std::mutex> lock(attachMutex);
+	for (Voice& voice : voices)
+	{
+		voice.sound.stop();
+		voice.sound.resetBuffer();
+	}
+}
+
+//! Function to give a sound its buffer and priority, the handle is kept here so the buffer outlives any voice playing it.
+/*!
+\param Sound sound - which sound.
+\param std::shared_ptr<const sf::SoundBuffer> buffer - its buffer.
+\param uint8_t priority - higher priority sounds take voices from lower ones when all are busy.
+*/
+void AudioEngine::setSound(Sound sound, std::shared_ptr<const sf::SoundBuffer> buffer, uint8_t priority)
+{
+	//the old buffer, if any, is kept too, a voice may still be playing it until the audio thread catches up.
+	if (buffers[sound] && buffers[sound] != buffer)
+	{
+		retired.push_back(buffers[sound]);
+	}
+	buffers[sound] = buffer;
+	commands.push({ Command::SET_BUFFER, (uint8_t)sound, priority, buffer.get() });
+}
+
+//! Function to ask for a sound to be played, a single push onto the queue, it starts on the audio thread within a millisecond or so.
+/*!
+\param Sound sound - which sound.
+*/
+void AudioEngine::play(Sound sound)
+{
+	//if the queue is full the audio thread has fallen far behind, and the effect is dropped.
+	commands.push({ Command::PLAY, (uint8_t)sound, 0, nullptr });
+}
+
+//! Function run by the audio thread, carrying out every command waiting then sleeping briefly when there are none.
+/*!
+\param - n/a
+*/
+void AudioEngine::run()
+{
+	Command batch[32];
+	while (running == true)
+	{
+		size_t count = commands.popBatch(batch, 32);
+		for (size_t i = 0; i < count; i++)
+		{
+			const Command& command = batch[i];
+			if (command.type == Command::SET_BUFFER)
+			{
+				soundBuffers[command.sound] = command.buffer;
+				soundPriorities[command.sound] = command.priority;
+			}
+			else
+			{
+				startSound(command.sound);
+			}
+		}
+		if (count == 0)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+//! Function to start a sound on a voice, attaching the voice to the sound's buffer first if it last played another.
+/*!
+\param uint8_t sound - which sound.
+*/
+void AudioEngine::startSound(uint8_t sound)
+{
+	const sf::SoundBuffer* buffer = soundBuffers[sound];
+	if (buffer == nullptr)
+	{
+		return;
+	}
+	Voice* voice = findVoice(soundPriorities[sound]);
+	if (voice == nullptr)
+	{
+		return;
+	}
+
+	voice->sound.stop();
+	if (voice->sound.getBuffer() != buffer)
+	{
+		//attaching changes the buffer's list of sounds, which is shared with other Games' audio threads.
+		std::lock_guard<std::mutex> lock(attachMutex);
+		voice->sound.setBuffer(*buffer);
+	}
+	voice->priority = soundPriorities[sound];
+	voice->started = plays++;
+	voice->sound.play();
+}
+
+//! Function to find a voice that isn't playing, or failing that the one to steal, the lowest priority at or below this one and the oldest of those.
+/*!
+\param uint8_t priority - priority of the sound to play.
+\return Voice* - the voice to use, or nullptr if every voice is playing something more important.
+*/
+AudioEngine::Voice* AudioEngine::findVoice(uint8_t priority)
+{
+	Voice* steal = nullptr;
+	for (Voice& voice : voices)
+	{
+		if (voice.sound.getStatus() != sf::Sound::Playing)
+		{
+			return &voice;
+		}
+		if (voice.priority > priority)
+		{
+			continue;
+		}
+		if (steal == nullptr || voice.priority < steal->priority || (voice.priority == steal->priority && voice.started < steal->started))
+		{
+			steal = &voice;
+		}
+	}
+	return steal;
+}
+#endif
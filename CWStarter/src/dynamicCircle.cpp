@@ -15,7 +15,7 @@
 \param uint16 maskBits -  - uint16 for physicalObject.h CollisionFilter enum, for what types object this will collide with.
 \param sf::Texture texture - an sfml reference to Texture to contain what texture this object should have.
 */
-DynamicCircle::DynamicCircle(b2World * world, const sf::Vector2f& position, const float radius, const float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture)
+DynamicCircle::DynamicCircle(b2World * world, const sf::Vector2f& position, const float radius, const float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture)
 {
 	//setting the texture for the object from the texture provided in the parameters.
 	setTexture(texture);
@@ -27,7 +27,6 @@ DynamicCircle::DynamicCircle(b2World * world, const sf::Vector2f& position, cons
 	bodyDef.type = b2_dynamicBody;
 	//creating a body in the world and assigning the above attributes.
 	body = world->CreateBody(&bodyDef);
-	body->SetUserData(this); // used by our contact listener
 
 	//the shape element of the object, circle so a radius.
 	b2CircleShape shape;
@@ -14,7 +14,7 @@
 \param uint16 maskBits -  - uint16 for physicalObject.h CollisionFilter enum, for what types object this will collide with.
 \param sf::Texture texture - an sfml reference to Texture to contain what texture this object should have.
 */
-DynamicRect::DynamicRect(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture)
+DynamicRect::DynamicRect(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture)
 {
 	//setting the texture for the object from the texture provided in the parameters.
 	setTexture(texture);
@@ -27,7 +27,6 @@ DynamicRect::DynamicRect(b2World* world, const sf::Vector2f position, const sf::
 
 	//creating a body in the world and assigning the above attributes.
 	body = world->CreateBody(&bodyDef);
-	body->SetUserData(this);	//to be used by the contact listener.
 
 	//the shape element of the object, as it's a rectangle no radius.
 	b2PolygonShape shape;
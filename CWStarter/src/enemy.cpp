@@ -19,7 +19,7 @@
 \param int frames - int for how many frames of animation are on the sprite sheet.
 \param float animDur - float for the time length required for each frame.
 */
-Enemy::Enemy(b2World* world, const sf::Vector2f& position, const sf::Vector2f size, float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture, sf::Sprite* sprite, int frames, float animDur)
+Enemy::Enemy(b2World* world, const sf::Vector2f& position, const sf::Vector2f size, float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture, sf::Sprite* sprite, int frames, float animDur)
 {
 	//setting the texture for the object from the texture provided in the parameters.
 	setTexture(texture);
@@ -35,10 +35,11 @@ Enemy::Enemy(b2World* world, const sf::Vector2f& position, const sf::Vector2f si
 	bodyDef.position.Set(position.x, position.y);
 	bodyDef.angle = orientation * DEG2RAD;
 	bodyDef.type = b2_dynamicBody;
+	//enemies start dormant, Game wakes them when the camera comes near.
+	bodyDef.active = false;
 
 	//creating a body in the world and assigning the above attributes.
 	body = world->CreateBody(&bodyDef);
-	body->SetUserData(this); // used by our contact listener
 
 	//the shape element of the object, circle so a radius.
 	b2PolygonShape shape;
@@ -73,10 +74,6 @@ Enemy::Enemy(b2World* world, const sf::Vector2f& position, const sf::Vector2f si
 	toRemove = false;
 	changeDirection = false;
 
-	//initialising the object pool locations.
-	b_objectPool = b2Vec2(-12.0f, -10.0f);
-	sf_objectPool = sf::Vector2f(-12.0f, -10.0f);
-
 	//initialise movingRight to false, so enemies with all start with a move to the left, towards the player.
 	movingRight = false;
 
@@ -84,6 +81,7 @@ Enemy::Enemy(b2World* world, const sf::Vector2f& position, const sf::Vector2f si
 	movementRange = 3.0f;
 	rightRange = position.x + movementRange;
 	leftRange = position.x - movementRange;
+	spawnPosition = b2Vec2(position.x, position.y);
 }
 
 //! Function to remove body, and therefore object, from world it is in.
@@ -96,42 +94,67 @@ Enemy::~Enemy()
 	//body->GetWorld()->DestroyBody(body);
 }
 
-//! Function to update the position and rotation of this object within its world, applying the movement function. As well as check update it's collision, range and removal checks.
+//! Function to apply the movement function once per physics step, as well as check and update it's collision and range checks.
 /*!
 \param - n/a
 */
-void Enemy::update()
+void Enemy::step()
 {
-	//updating position of the object.
-	b2Vec2 position = body->GetPosition();
-	setPosition(position.x, position.y);
-	float angle = body->GetAngle() * RAD2DEG;
-	setRotation(angle);
-
 	//check enemy has collided with obstacle, then within its movement range and then apply relevant movement.
 	obstacleCollisionCheck();
 	rangeCheck();
 	enemyMovement();
-
-	//check whether enemy object needs to be deactivated and pooled.
-	toBeRemovedCheck();
 }
 
-//! Function to to check whether toRemove bool is true and then deactive object and put back into its object pool location.
+//! Function to wake the enemy, so its body collides and moves again. Removed enemies stay asleep.
 /*!
-\param n/a
+\param - n/a
 */
-void Enemy::toBeRemovedCheck()
+void Enemy::activate()
 {
-	//if objectContactListener sets toRemove to true, then deactive body and move to object pool.
-	if (toRemove == true)
+	if (toRemove == false)
 	{
-		body->SetActive(false);
-		body->SetTransform(b2Vec2(b_objectPool), 0.0f);
-		setPosition(sf_objectPool);
+		body->SetActive(true);
 	}
 }
 
+//! Function to put the enemy to sleep, its body keeps its place and velocity but takes no part in the simulation.
+/*!
+\param - n/a
+*/
+void Enemy::deactivate()
+{
+	body->SetActive(false);
+}
+
+//! Function to take the enemy out of the world, called by Game after the step it was stomped in.
+/*!
+\param n/a
+*/
+void Enemy::despawn()
+{
+	//bodies can't be changed during the step, so this waits until the contact listener has finished.
+	body->SetActive(false);
+}
+
+//! Function to put the enemy back in the world at a spawn position, reset and asleep until the camera nears it.
+/*!
+\param b2Vec2 position - where to spawn.
+*/
+void Enemy::spawn(const b2Vec2& position)
+{
+	body->SetTransform(position, 0.0f);
+	body->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+	setPosition(position.x, position.y);
+
+	toRemove = false;
+	changeDirection = false;
+	movingRight = false;
+	spawnPosition = position;
+	rightRange = position.x + movementRange;
+	leftRange = position.x - movementRange;
+}
+
 //! Function to apply a limited force on the x-axis in the required direction of movement.
 /*!
 \param - n/a
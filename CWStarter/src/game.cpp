@@ -1,4 +1,8 @@
 #include "game.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <memory>
 
 /*! \file game.cpp
 * \brief Contains functions for initialising, updating and drawing the world and all objects within.
@@ -10,9 +14,9 @@
 
 //! Function to be called in main.cpp to initiate and create the entire game world.
 /*!
-\param - n/a
+\param std::string levelName - the level to play, world 1-1 if empty. A level file, or a generated level spec (see LevelGenerator::fromSpec).
 */
-Game::Game()
+Game::Game(const std::string& levelName)
 {
 	//setting the size * origin or view, then creating the world and applying the debug draw to this world.
 	view.setCenter(0.0f, 0.0f);
@@ -20,31 +24,60 @@ Game::Game()
 	world = new b2World(gravity);
 	debugDraw.setWorld(world);
 
-	//functions to initialise all required textures, fonts, texts, sounds and vars.
+	//initialise the vars, then queue the textures, font, sounds and level to load, in the order they are finished in.
+	initValues();
 	initTexture();
 	initFontsTexts();
 	initAudio();
-	initValues();
 
-	//function to populate the world with the required objects.
-	populateWorld();
+	//function to populate the world with the required objects, once the level and textures have loaded.
+	populateWorld(levelName);
 
+#ifndef HEADLESS
+	//decode everything off the main thread, the window shows the loading screen until finishLoading() has finished it all.
+	loader.start();
+#else
+	//nothing to draw while waiting headless, so load it all now and be ready to step straight away.
+	loader.loadNow();
+#endif
+}
+
+//! Function to tag the bodies, set the contact listener and start the music, once the world is built.
+/*!
+\param - n/a
+*/
+void Game::startLevel()
+{
 	//get bodies from moving objects that require force to be added to them.
 	playerBody = playerObject[0].getBody();
 
 	//prevent the player object from rotating.
 	playerBody->SetFixedRotation(true);
 	
-	//grabbing and assigning the userData (for the listeners) to each object, using a pair with it's name and a void pointer.
-	for (StaticRect& block : staticBlock) block.setUserData(new std::pair<std::string, void *>(typeid(decltype(block)).name(), &block));
-	for (Player& player : playerObject) player.setUserData(new std::pair<std::string, void *>(typeid(decltype(player)).name(), &player));
-	for (Enemy& enemy : enemyObject) enemy.setUserData(new std::pair<std::string, void*>(typeid(decltype(enemy)).name(), &enemy));
-	for (Item& items : itemList) items.setUserData(new std::pair<std::string, void *>(typeid(decltype(items)).name(), &items));
-	for (Obstacle& obstacles : obstaclesList) obstacles.setUserData(new std::pair<std::string, void*>(typeid(decltype(obstacles)).name(), &obstacles));
-	for (StaticSensor& sensor : staticSensors) sensor.setUserData(new std::pair<std::string, void *>(typeid(decltype(sensor)).name(), &sensor));
+	//the players are tagged here, the streamed objects are tagged as their chunk is built.
+	for (size_t i = 0; i < playerObject.size(); i++) playerObject[i].setTag({ BodyTag::PLAYER, (uint16)i });
+	listener.setObjectLists(&staticBlock, &playerObject, &enemyObject, &itemList, &obstaclesList, &staticSensors);
 
 	//setting the contact listener in the world.
 	world->SetContactListener(&listener);
+
+	//set the music to playing, if it loaded.
+	if (musicLoaded == true)
+	{
+		mainMarioMusic.play();
+	}
+}
+
+//! Function to finish a few more of the assets that have loaded, called once per frame while loading so no frame stalls on the uploads.
+/*!
+\param - n/a
+\return bool - whether everything has loaded and the game can be updated.
+*/
+bool Game::finishLoading()
+{
+	bool finished = loader.finish(uploadsPerFrame);
+	loadingFill.setSize(sf::Vector2f(loadingBar.getSize().x * loader.getProgress(), loadingBar.getSize().y));
+	return finished;
 }
 
 //! Function to to delete the world and set the pointer back to null.
@@ -53,6 +86,9 @@ Game::Game()
 */
 Game::~Game()
 {
+	//stop any decode or chunk read still running before what it decodes into goes.
+	loader.stop();
+	levelStream.close();
 	delete world;
 	world = nullptr;
 }
@@ -64,36 +100,83 @@ Game::~Game()
 */
 void Game::draw(sf::RenderTarget &target, sf::RenderStates states) const
 {
-	//set the view.
-	target.setView(view);
+	STAGE_SCOPE(profiler, STAGE_DRAW);
 
-	//draw background and the UI text in the scene.
-	target.draw(bgPicture);
+	//until everything has loaded there is no world to draw, just the loading bar.
+	if (isLoading() == true)
+	{
+		target.setView(uiView);
+		target.draw(loadingBar);
+		target.draw(loadingFill);
+		return;
+	}
+
+	//each pass is a span of its own in a trace.
+	{
+		TRACE_SCOPE("world", "draw");
+		//set the view.
+		target.setView(view);
+
+		//the background, repeated along the level as generated levels run far past its end, only the copies in view are drawn.
+		int lastTile = (int)std::floor((visibleRight - bgLeft) / bgWidth);
+		for (int tile = std::max((int)std::floor((visibleLeft - bgLeft) / bgWidth), 0); tile <= lastTile; tile++)
+		{
+			sf::RenderStates tileStates;
+			tileStates.transform.translate(tile * bgWidth, 0.0f);
+			target.draw(bgPicture, tileStates);
+		}
+		//then the ground each chunk baked when it was built, one draw call per visible chunk with no vertex work.
+		for (const ResidentChunk& chunk : residentChunks) if (chunk.right >= visibleLeft && chunk.left <= visibleRight) target.draw(chunk.ground);
+
+		//gather the objects that move or can be collected into one batch per texture, then draw each batch in one call.
+		//with every texture in the atlas this is a single draw call.
+		spriteBatch.clear();
+		//only the objects overlapping the camera are added, in the same layers as before.
+		for (size_t i = 0; i < playerObject.size(); i++) spriteBatch.add(atlas->getTexture(), transforms, i);
+		for (const BodyTag& tag : visibleObjects) if (tag.kind == BodyTag::ITEM) spriteBatch.add(itemList[tag.index]);
+		for (size_t i = firstAwakeEnemy; i < endAwakeEnemy; i++)
+		{
+			if (!enemyObject.isActive(enemyWakeOrder[i])) continue;
+			size_t transform = firstEnemyTransform + i;
+			float x = transforms.renderX[transform];
+			float halfWidth = transforms.halfWidth[transform];
+			if (x + halfWidth >= visibleLeft && x - halfWidth <= visibleRight) spriteBatch.add(atlas->getTexture(), transforms, transform);
+		}
+		target.draw(spriteBatch);
+
+		//the obstacles go over the enemies, baked the same way as the ground.
+		for (const ResidentChunk& chunk : residentChunks) if (chunk.right >= visibleLeft && chunk.left <= visibleRight) target.draw(chunk.obstacles);
+	}
 
-	//draw all the objects in the world.
-	for (auto gBlock : staticBlock) target.draw(gBlock);
-	for (auto player : playerObject) target.draw(player);
-	for (auto items : itemList) target.draw(items);
-	for (auto enemy : enemyObject) target.draw(enemy);
-	for (auto obstacles : obstaclesList) target.draw(obstacles);
-	
-	//set view for UI and draw UI text.
-	target.setView(uiView);
-	target.draw(scoreText);
-	target.draw(timerText);
-	target.draw(livesText);
-	target.draw(tutorialText);
-	
-	//check whether level is complete, if so draw the victory text too.
-	if (levelComplete == true)
 	{
-		target.draw(victoryText1);
-		target.draw(victoryText2);
+		TRACE_SCOPE("debug", "draw");
+		//debug draw, in the world's view so only what the camera sees is drawn, under the UI.
+		if (debug == true)
+			target.draw(debugDraw);
 	}
 
-	//debug draw.
-	if (debug == true)
-		target.draw(debugDraw);
+	{
+		TRACE_SCOPE("ui", "draw");
+		//set view for UI and draw UI text.
+		target.setView(uiView);
+		target.draw(scoreText);
+		target.draw(timerText);
+		target.draw(livesText);
+		target.draw(tutorialText);
+	
+		//check whether level is complete, if so draw the victory text too.
+		if (levelComplete == true)
+		{
+			target.draw(victoryText1);
+			target.draw(victoryText2);
+		}
+	}
+
+#ifdef PROFILING
+	//the frame profile, over the UI so it stays put as the camera moves.
+	if (showProfile == true)
+		target.draw(profiler);
+#endif
 }
 
 //! Function to update the world will all changes each step, called in main.cpp
@@ -102,62 +185,127 @@ void Game::draw(sf::RenderTarget &target, sf::RenderStates states) const
 */
 void Game::update(float timestep)
 {
-	//update the world.
-	world->Step(timestep, velocityIterations, positionIterations);
+	//advance the simulated clocks used by the UI timer and the player animation.
+	uiElapsedTime += timestep;
+	elapsedTime += timestep;
 
-	//checking updates on score and canJump from contact listener.
-	ocl.scoreCounter(score);
-	ocl.isPlayerGrounded(canJump);
-	ocl.isPlayerDead(isDead);
-	ocl.playAudio(playCoinSFX, playHurtSFX);
+	//each stage below is timed for the profile overlay when built with PROFILING, and traced when built with TRACING, otherwise it is a plain block.
+	{
+		STAGE_SCOPE(profiler, STAGE_STREAMING);
+		//build the level ahead of the camera and tear it down behind, decided by the simulation alone so replays build the same world.
+		streamChunks();
+	}
 
-	//if player is dead, then playerDead().
-	if (isDead == true)
 	{
-		playerDead();
+		STAGE_SCOPE(profiler, STAGE_ACTIVATION);
+		//wake or sleep enemies as the camera moves, only the awake ones are simulated.
+		updateEnemyActivation();
+
+		//keep the dynamic bodies' transforms from before stepping, so rendering can interpolate between steps.
+		transforms.savePrevious(0, playerObject.size());
+		transforms.savePrevious(firstEnemyTransform + firstAwakeEnemy, firstEnemyTransform + endAwakeEnemy);
 	}
-	//checking whether below SFXs need to be played.
-	if (playCoinSFX == true)
+
 	{
-		pickUpSFX.play();
+		STAGE_SCOPE(profiler, STAGE_STEP);
+		//update the world, then read back where the bodies moved to.
+		world->Step(timestep, velocityIterations, positionIterations);
+		transforms.capture(0, playerObject.size());
+		transforms.capture(firstEnemyTransform + firstAwakeEnemy, firstEnemyTransform + endAwakeEnemy);
 	}
-	if (playHurtSFX == true)
+#ifdef PROFILING
+	//box2d's own breakdown of the step, collide, solve and broadphase.
+	profiler.addWorldProfile(world->GetProfile());
+#endif
+
 	{
-		marioHitSFX.play();
+		STAGE_SCOPE(profiler, STAGE_CONTACTS);
+		//apply the step's events from the contact listener, in the order they happened, a batch at a time.
+		size_t count;
+		while ((count = listener.getEvents().popBatch(eventBatch.data(), eventBatch.size())) > 0)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				handleEvent(eventBatch[i]);
+			}
+		}
+
+		//release whatever was stomped or collected, it leaves the update and draw sets straight away.
+		releaseRemoved();
+
+		//if player is dead, then playerDead().
+		if (isDead == true)
+		{
+			playerDead();
+		}
 	}
 
-	//checking to see if fallen off screen.
-	fallenOffScreenCheck();
+	{
+		STAGE_SCOPE(profiler, STAGE_PLAYER);
+		//checking to see if fallen off screen.
+		fallenOffScreenCheck();
 
-	//calling function which looks after all the impulses for player movement.
-	playerMovement();
+		//calling function which looks after all the impulses for player movement.
+		playerMovement();
+	}
 
-	//call function to animate the player sprite.
-	animatePlayer();
+	{
+		STAGE_SCOPE(profiler, STAGE_ANIMATION);
+		//call function to animate the player sprite.
+		animatePlayer();
+	}
 
-	//update score, time and lives in UI.
-	updateUI();
+	{
+		STAGE_SCOPE(profiler, STAGE_UI);
+		//update score, time and lives in UI.
+		updateUI();
+	}
 
-	//update all the game objects, their rendering positions.
-	for (auto& player : playerObject) player.update();
-	for (auto& items : itemList) items.update();
-	for (auto& enemy : enemyObject) enemy.update();
+	{
+		STAGE_SCOPE(profiler, STAGE_ENTITIES);
+		//find what is on screen, then update all the game objects' per step logic.
+		cullToView();
+		for (size_t i = firstAwakeEnemy; i < endAwakeEnemy; i++) if (enemyObject.isActive(enemyWakeOrder[i])) enemyObject[enemyWakeOrder[i]].step();
+	}
 
-	//calling function which updates the position of the camera/view to the players position but keeps in-bounds too.
-	cameraController();
+	{
+		STAGE_SCOPE(profiler, STAGE_RULES);
+		//check whether current checkpoint needs updating
+		checkpointMan();
 
-	//check whether current checkpoint needs updating
-	checkpointMan();
+		//check whether level is complete.
+		completedLevel();
 
-	//check whether level is complete.
-	completedLevel();
+		//check whether game win/lose condidtions met.
+		gameConditions();
+	}
+}
+
+//! Function to update the rendering positions of the moving objects and the camera, called once per rendered frame in main.cpp
+/*!
+\param float alpha - how far the rendered frame is between the previous and current physics step, 0 to 1.
+*/
+void Game::interpolate(float alpha)
+{
+	STAGE_SCOPE(profiler, STAGE_INTERPOLATE);
 
-	//check whether game win/lose condidtions met.
-	gameConditions();
+	//blend the moving objects between their last two physics steps.
+	transforms.interpolate(0, playerObject.size(), alpha);
+	transforms.interpolate(firstEnemyTransform + firstAwakeEnemy, firstEnemyTransform + endAwakeEnemy, alpha);
 
-	//delete debug shapes.
-	if (debug == true)
-		debugDraw.clear();
+	//calling function which updates the position of the camera/view to the players position but keeps in-bounds too.
+	cameraController();
+}
+
+//! Function to end the frame, storing its stage timings and the world's body and contact counts in the profile.
+/*!
+\param - n/a
+*/
+void Game::endFrame()
+{
+#ifdef PROFILING
+	profiler.endFrame(world);
+#endif
 }
 
 //! Function to toggle debug mode.
@@ -169,42 +317,76 @@ void Game::toggleDebug()
 	debug = !debug;
 }
 
-//! Function to initialise all required textures.
+//! Function to queue the textures to load, or share them with another Game that already has.
 /*!
 \param - n/a
 */
 void Game::initTexture()
 {
-	//reference to the PhysicalObject class.
-	PhysicalObject po;
-	
+#ifndef HEADLESS
+	//decode the atlas packed by CWAtlasPack, one decode and upload for every texture.
+	//if it hasn't been built, pack the separate textures in memory instead, with a placeholder for any that are missing.
+	std::shared_ptr<sf::Image> image = std::make_shared<sf::Image>();
+	loader.addShared<TextureAtlas>("textures", "./assets/textures/atlas.txt", [image](TextureAtlas& loading) {
+		if (loading.decode("./assets/textures/", "atlas.txt", *image))
+		{
+			return true;
+		}
+		std::cout << "texture atlas not built, packing textures at load" << std::endl;
+		const std::vector<std::string> textureFiles = {
+			"world_01_01.png", "brick_1x1_01.png", "brick_2x1_01.png", "brick_3x1_01.png", "brick_4x1_01.png",
+			"stone_brown_12x4.png", "hard_block_01.png", "mario_idle_01.png", "mario_run_spritesheet_01.png",
+			"coin_01.png", "tube_3x2_01.png", "tube_3x4_01.png", "victory_flag_01.png",
+			"mushroom_spritesheet_01.png", "mushroom_dead_01.png"
+		};
+		return loading.pack("./assets/textures/", textureFiles, *image, true);
+	}, [image](TextureAtlas& loading, bool) {
+		//the image is packed even if textures were missing, so it is always uploaded.
+		loading.upload(*image);
+	}, [this](std::shared_ptr<const TextureAtlas> loaded) {
+		atlas = loaded;
+		initTextureRects();
+	});
+#else
+	//nothing is drawn headless, an empty atlas stands in.
+	atlas = std::make_shared<TextureAtlas>();
+#endif
+}
+
+//! Function to look up where each texture is in the atlas, once it has loaded.
+/*!
+\param - n/a
+*/
+void Game::initTextureRects()
+{
 	//backfround texture and object.
-	po.loadTexture(background, "world_01_01.png");
-	bgPicture.setSize(sf::Vector2f(140, 8));
-	bgPicture.setTexture(&background);
-	bgPicture.setPosition(-6.0f, -3.85f);
+	background = atlas->getRect("world_01_01.png");
+	bgPicture.setSize(sf::Vector2f(bgWidth, 8));
+	bgPicture.setTexture(atlas->getTexture());
+	bgPicture.setTextureRect(background);
+	bgPicture.setPosition(bgLeft, -3.85f);
 	
-	//load up ground textures.
-	po.loadTexture(brick1x1, "brick_1x1_01.png");
-	po.loadTexture(brick2x1, "brick_2x1_01.png");
-	po.loadTexture(brick3x1, "brick_3x1_01.png");
-	po.loadTexture(brick4x1, "brick_4x1_01.png");
-	po.loadTexture(stones, "stone_brown_12x4.png");
-	po.loadTexture(solidBlock, "hard_block_01.png");
-
-	//load up mario player textures.
-	po.loadTexture(marioIdle, "mario_idle_01.png");
-	po.loadTexture(marioWalkingSpritesheet, "mario_run_spritesheet_01.png");
-
-	//load up item textures.
-	po.loadTexture(coin, "coin_01.png");
-	po.loadTexture(smallTube, "tube_3x2_01.png");
-	po.loadTexture(bigTube, "tube_3x4_01.png");
-	po.loadTexture(flag, "victory_flag_01.png");
-
-	//load up ememy textures.
-	po.loadTexture(goombaWalkingSpriteSheet, "mushroom_spritesheet_01.png");
-	po.loadTexture(goombaDead, "mushroom_dead_01.png");
+	//ground textures.
+	brick1x1 = atlas->getRect("brick_1x1_01.png");
+	brick2x1 = atlas->getRect("brick_2x1_01.png");
+	brick3x1 = atlas->getRect("brick_3x1_01.png");
+	brick4x1 = atlas->getRect("brick_4x1_01.png");
+	stones = atlas->getRect("stone_brown_12x4.png");
+	solidBlock = atlas->getRect("hard_block_01.png");
+
+	//mario player textures.
+	marioIdle = atlas->getRect("mario_idle_01.png");
+	marioWalkingSpritesheet = atlas->getRect("mario_run_spritesheet_01.png");
+
+	//item textures.
+	coin = atlas->getRect("coin_01.png");
+	smallTube = atlas->getRect("tube_3x2_01.png");
+	bigTube = atlas->getRect("tube_3x4_01.png");
+	flag = atlas->getRect("victory_flag_01.png");
+
+	//ememy textures.
+	goombaWalkingSpriteSheet = atlas->getRect("mushroom_spritesheet_01.png");
+	goombaDead = atlas->getRect("mushroom_dead_01.png");
 }
 
 //! Function to initialise all required fonts and texts.
@@ -216,93 +398,147 @@ void Game::initFontsTexts()
 	//setting the view to take the UI input.
 	uiView = sf::View(sf::Vector2f(400, 300), sf::Vector2f(800, 600));
 
-	//load the font, throw an error and exit if fails to do so.
-	if (!uiFont.loadFromFile("./assets/fonts/mario.ttf")) {
-		std::cout << "Error loading UI font" << std::endl;
-		exit(0);
-	}
+	//the loading bar, drawn across the middle of the screen until everything has loaded.
+	loadingBar.setSize(sf::Vector2f(400, 20));
+	loadingBar.setPosition(200, 290);
+	loadingBar.setFillColor(sf::Color(0, 0, 0, 96));
+	loadingFill.setSize(sf::Vector2f(0, 20));
+	loadingFill.setPosition(200, 290);
+	loadingFill.setFillColor(sf::Color::Red);
+
+#ifndef HEADLESS
+	//read the font off the main thread, then open it from memory, which is kept with it for as long as the font.
+	//if it won't load the texts are left with no glyphs, so draw nothing.
+	loader.addShared<FontAsset>("UI font", "./assets/fonts/mario.ttf", [](FontAsset& loading) {
+		return readFile("./assets/fonts/mario.ttf", loading.data);
+	}, [](FontAsset& loading, bool decoded) {
+		if (decoded == true)
+		{
+			loading.font.loadFromMemory(loading.data.data(), loading.data.size());
+		}
+	}, [this](std::shared_ptr<const FontAsset> loaded) {
+		uiFont = loaded;
+		for (sf::Text* text : std::initializer_list<sf::Text*>{ &scoreText, &timerText, &livesText, &tutorialText, &victoryText1, &victoryText2, &gameOverText })
+		{
+			text->setFont(uiFont->font);
+		}
+#ifdef PROFILING
+		profiler.setFont(&uiFont->font);
+#endif
+	});
+#endif
 
 	//setting all required for score text.
-	scoreText.setFont(uiFont);
-	scoreText.setString("Score: 0");
+	scoreText.setLabel("Score: ");
 	scoreText.setCharacterSize(30);
 	scoreText.setFillColor(sf::Color::Red);
 	scoreText.setPosition(sf::Vector2f(20, 2));
 	//for timer text.
-	timerText.setFont(uiFont);
-	timerText.setString("Timer: 0");
+	timerText.setLabel("Time: ");
 	timerText.setCharacterSize(30);
 	timerText.setFillColor(sf::Color::Red);
 	timerText.setPosition(320, 2);
 	//for lives text.
-	livesText.setFont(uiFont);
-	livesText.setString("Lives: 0");
+	livesText.setLabel("Lives: ");
 	livesText.setCharacterSize(30);
 	livesText.setFillColor(sf::Color::Red);
 	livesText.setPosition(650, 2);
 	//for tutorial text.
-	tutorialText.setFont(uiFont);
 	tutorialText.setString("Press the DIRECTIONAL BUTTONS to move. \nThe SPACE BAR to jump. \nAnd M to un/mute.");
 	tutorialText.setCharacterSize(22);
 	tutorialText.setFillColor(sf::Color::Red);
 	tutorialText.setPosition(20, 50);
 	//for victory1 text.
-	victoryText1.setFont(uiFont);
 	victoryText1.setString("");
 	victoryText1.setCharacterSize(50);
 	victoryText1.setFillColor(sf::Color::Red);
 	victoryText1.setPosition(100, 150);
 	//for victory2 text.
-	victoryText2.setFont(uiFont);
 	victoryText2.setString("");
 	victoryText2.setCharacterSize(40);
 	victoryText2.setFillColor(sf::Color::Red);
 	victoryText2.setPosition(250, 250);
 	//for game over text.
-	gameOverText.setFont(uiFont);
 	gameOverText.setString("");
 	gameOverText.setCharacterSize(50);
 	gameOverText.setFillColor(sf::Color::Red);
 	gameOverText.setPosition(400, 300);
 }
 
-//! Function to initalise all required audio.
+//! Function to queue all the audio to load.
 /*!
 \param - n/a
 */
 void Game::initAudio()
 {
-	//open up the music track required.
-	if (!mainMarioMusic.openFromFile("./assets/audio/Main_Theme_01.ogg"))
-	{
-		std::cout << "Error loading Main Theme music track" << std::endl;
-		exit(0);
-	}
+#ifndef HEADLESS
+	//read the music track off the main thread, it is then streamed from memory, decoding as it plays.
+	//each Game streams its own sf::Music, but from the one shared copy of the file.
+	loader.addShared<std::vector<char>>("Main Theme music track", "./assets/audio/Main_Theme_01.ogg", [](std::vector<char>& loading) {
+		return readFile("./assets/audio/Main_Theme_01.ogg", loading);
+	}, [](std::vector<char>&, bool) {}, [this](std::shared_ptr<const std::vector<char>> loaded) {
+		musicData = loaded;
+		musicLoaded = !musicData->empty() && mainMarioMusic.openFromMemory(musicData->data(), musicData->size());
+	});
+
+	//decode the short clips required off the main thread, and hand them to the audio engine on it.
+	//a clip that won't load leaves its buffer empty, so the SFX plays silence.
+	//priorities decide which effect keeps a voice when they are all busy, death over stomps over jumps and coins.
+	addSound("Mario Jump sound file", "./assets/audio/Jump_01.wav", AudioEngine::JUMP, 1);
+	addSound("Mario Hit sound file", "./assets/audio/Hit_01.wav", AudioEngine::HIT, 2);
+	addSound("Mario Dead sound file", "./assets/audio/PlayerDead_01.wav", AudioEngine::DEAD, 3);
+	addSound("Item Pick-Up sound file", "./assets/audio/PickUp_01.wav", AudioEngine::PICK_UP, 1);
+#endif
+}
 
-	//load up required short clips required, exit if fail to do so.
-	if (!marioJumpBuffer.loadFromFile("./assets/audio/Jump_01.wav")) {
-		std::cout << "Error loading Mario Jump sound file" << std::endl;
-		exit(0);
-	}
-	if (!marioHitBuffer.loadFromFile("./assets/audio/Hit_01.wav")) {
-		std::cout << "Error loading Mario Hit sound file" << std::endl;
-		exit(0);
-	}
-	if (!marioDeadBuffer.loadFromFile("./assets/audio/PlayerDead_01.wav")) {
-		std::cout << "Error loading Mario Dead sound file" << std::endl;
-		exit(0);
-	}
-	if (!pickUpBuffer.loadFromFile("./assets/audio/PickUp_01.wav")) {
-		std::cout << "Error loading Item Pick-Up sound file" << std::endl;
-		exit(0);
+#ifndef HEADLESS
+//! Function to queue a sound clip to load, or share it with another Game that already has, decoded to samples on a worker and given to the audio engine once in its buffer.
+/*!
+\param std::string name - what the clip is, for the log.
+\param std::string fileName - the clip's file.
+\param AudioEngine::Sound sound - the SFX that plays it.
+\param uint8_t priority - the SFX's priority for a voice.
+*/
+void Game::addSound(const std::string& name, const std::string& fileName, AudioEngine::Sound sound, uint8_t priority)
+{
+	std::shared_ptr<DecodedSound> decoded = std::make_shared<DecodedSound>();
+	loader.addShared<sf::SoundBuffer>(name, fileName, [fileName, decoded](sf::SoundBuffer&) {
+		sf::InputSoundFile file;
+		if (!file.openFromFile(fileName))
+		{
+			return false;
+		}
+		decoded->channelCount = file.getChannelCount();
+		decoded->sampleRate = file.getSampleRate();
+		decoded->samples.resize((size_t)file.getSampleCount());
+		return file.read(decoded->samples.data(), decoded->samples.size()) == decoded->samples.size();
+	}, [decoded](sf::SoundBuffer& loading, bool loaded) {
+		if (loaded == true)
+		{
+			loading.loadFromSamples(decoded->samples.data(), decoded->samples.size(), decoded->channelCount, decoded->sampleRate);
+		}
+	}, [this, sound, priority](std::shared_ptr<const sf::SoundBuffer> loaded) {
+		audio.setSound(sound, loaded, priority);
+	});
+}
+#endif
+
+//! Function to read a whole file into memory, the disk half of loading an asset that is then opened from memory.
+/*!
+\param std::string fileName - the file.
+\param std::vector<char> data - filled with the file's bytes.
+\return bool - whether the file was read.
+*/
+bool Game::readFile(const std::string& fileName, std::vector<char>& data)
+{
+	std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
 	}
-	
-	//set the relevant sound buffers to the SFXs.
-	marioJumpSFX.setBuffer(marioJumpBuffer);
-	marioHitSFX.setBuffer(marioHitBuffer);
-	marioDeadSFX.setBuffer(marioDeadBuffer);
-	pickUpSFX.setBuffer(pickUpBuffer);
-	
+	data.resize((size_t)file.tellg());
+	file.seekg(0);
+	return (bool)file.read(data.data(), data.size());
 }
 
 //! Function to initalise all required var values.
@@ -323,31 +559,21 @@ void Game::initValues()
 	lives = 3;
 	totalTime = 180.0f;
 	currentTime = totalTime;
+	uiElapsedTime = 0.0f;
+	elapsedTime = 0.0f;
 
 	//initialising bools for jumping and player dead.
 	canJump = false;
 	isDead = false;
 	levelComplete = false;
+	gameOver = false;
 
-	//set the music to playing and bool to true.
-	mainMarioMusic.play();
+	//the music starts with the level, unmuted.
 	musicPlaying = true;
-	bool playCoinSFX = false;
-	bool playHurtSFX = false;
 
 	//setting IntRect for looking left and right, to flip mario sprite to look in direction of movement.
 	lookRight = sf::IntRect(0, 0, 50, 50);
 	lookLeft = sf::IntRect(50, 0, -50, 50);
-
-	//init start co-ords in world and standard block size and the end co-ords x-pos.
-	startPosition = b2Vec2(-3.0f, 2.0f);
-	endPosition = 125.0f;
-	//initialising positions of checkpoints and setting current checkpoint location.
-	currentCheckpoint = startPosition;
-	checkpoint1 = 25.0f;
-	checkpoint2 = 50.0f;
-	checkpoint3 = 75.0f;
-	checkpoint4 = 100.0f;
 }
 
 //! Function to update the UI text elements with changes.
@@ -356,9 +582,7 @@ void Game::initValues()
 */
 void Game::updateUI()
 {
-	//getting a clock timer, taking that away from totalTime and then setting to int to be displayed in UI.
-	uiElapsedTime = timerClock.getElapsedTime().asSeconds();
-
+	//taking the simulated elapsed time away from totalTime and then setting to int to be displayed in UI.
 	//checking whether level is complete, is so then pause the current time.
 	if (levelComplete == false)
 	{
@@ -369,28 +593,53 @@ void Game::updateUI()
 		currentTime = currentTime;
 	}
 
-	//convert from float to int to add to string.
+	//convert from float to int to be displayed.
 	int i_time = (int)currentTime;
 
-	//setting int vars to strings.
-	std::string currentScore = "Score: " + std::to_string(score);
-	std::string currentLives = "Lives: " + std::to_string(lives);
-	std::string currentTime;
+	//each text only reformats when the number it shows changes, the timer once a second and score and lives rarely.
+	scoreText.setValue(score);
+	livesText.setValue(lives);
 
-	//if time drops below 0, set string to "times up".
-	if(i_time > 0)
+	//if time drops below 0, show "times up".
+	if (i_time > 0)
 	{
-		currentTime = "Time: " + std::to_string(i_time);
+		timerText.setValue(i_time);
 	}
 	else
 	{
-		currentTime = "Time: Time is up!";
+		timerText.setMessage("Time is up!");
 	}
+}
 
-	//setting above strings to to the UI texts.
-	scoreText.setString(currentScore);
-	timerText.setString(currentTime);
-	livesText.setString(currentLives);
+//! Function to act on one event from the contact listener.
+/*!
+\param GameEvent event - what happened.
+*/
+void Game::handleEvent(const GameEvent& event)
+{
+	switch (event.type)
+	{
+	case GameEvent::COIN_COLLECTED:
+		score = score + coinScore;
+		audio.play(AudioEngine::PICK_UP);
+		break;
+	case GameEvent::ENEMY_STOMPED:
+		score = score + stompScore;
+		audio.play(AudioEngine::HIT);
+		break;
+	case GameEvent::PLAYER_HIT:
+		isDead = true;
+		break;
+	case GameEvent::PLAYER_HIT_ENDED:
+		isDead = false;
+		break;
+	case GameEvent::GROUNDED:
+		canJump = true;
+		break;
+	case GameEvent::UNGROUNDED:
+		canJump = false;
+		break;
+	}
 }
 
 //! Function to take and process all inputted keys from the user and give desired actions to those inputs.
@@ -425,10 +674,12 @@ void Game::userInput(sf::Keyboard::Key key)
 	case sf::Keyboard::E:
 		//debug to take player to the end of level, so can show the end 'Victory' condition.
 		playerBody->SetTransform(b2Vec2(120.0f, 3.0f), 0.0f);
+		transforms.snap(0);
 		break;
 	case sf::Keyboard::S:
 		//debug to move player through level, to check world and show examples of play.
 		playerBody->SetTransform(b2Vec2((currentPosition.x + 10.0f), 3.0f), 0.0f);
+		transforms.snap(0);
 		break;
 	case sf::Keyboard::P:
 		//debug to get x-pos of mario 
@@ -437,6 +688,25 @@ void Game::userInput(sf::Keyboard::Key key)
 	case sf::Keyboard::M:
 		muteMusic();
 		break;
+	case sf::Keyboard::F3:
+		//debug layers, drawn over the shapes while debug mode is on.
+		debugDraw.toggleFlag(b2Draw::e_aabbBit);
+		break;
+	case sf::Keyboard::F4:
+		debugDraw.toggleFlag(b2Draw::e_pairBit);
+		break;
+	case sf::Keyboard::F5:
+		debugDraw.toggleFlag(b2Draw::e_centerOfMassBit);
+		break;
+	case sf::Keyboard::F6:
+		debugDraw.toggleFlag(b2Draw::e_jointBit);
+		break;
+#ifdef PROFILING
+	case sf::Keyboard::F1:
+		//show or hide the frame profile overlay.
+		showProfile = !showProfile;
+		break;
+#endif
 	default:
 		movingRight = false;
 		movingLeft = false;
@@ -459,7 +729,7 @@ void Game::muteMusic()
 	}
 	else if (musicPlaying == false)
 	{
-		mainMarioMusic.play();
+		if (musicLoaded == true) mainMarioMusic.play();
 		musicPlaying = true;
 	}
 	else
@@ -520,7 +790,7 @@ void Game::playerJump()
 		float currentXImpulse = playerBody->GetLinearVelocity().x;
 		impulse = playerBody->GetMass() * 10;
 		playerBody->ApplyLinearImpulseToCenter(b2Vec2(0.0f, impulse), true);
-		marioJumpSFX.play();
+		audio.play(AudioEngine::JUMP);
 	}
 }
 
@@ -545,18 +815,14 @@ void Game::stopMovement(sf::Keyboard::Key key)
 */
 void Game::animatePlayer()
 {
-	//keeping a clock going through out scene.
-	elapsedTime = marioClock.getElapsedTime().asSeconds();
-
 	isWalking = isMoving();
 	if (isWalking == true)
 	{
 		//set the sprite for the player to be the walking sprite and looped.
-		playerObject[0].setTexture(&marioWalkingSpritesheet);
 		if (movingRight == true)
 		{
 			//flip to have sprite looking to the right direction.
-			playerObject[0].setTextureRect(lookRight);
+			transforms.spriteRects[0] = TextureAtlas::subRect(marioWalkingSpritesheet, lookRight);
 			//get animating...
 			if (elapsedTime > 0.5f)
 			{
@@ -565,15 +831,15 @@ void Game::animatePlayer()
 				} else {
 					lookRight.left += 50;
 				}
-				playerObject[0].setTextureRect(lookRight);
-				marioClock.restart();
+				transforms.spriteRects[0] = TextureAtlas::subRect(marioWalkingSpritesheet, lookRight);
+				elapsedTime = 0.0f;
 			}
 			rightLast = true;
 		}
 		else if (movingLeft == true)
 		{
 			//flip to have sprite looking to the left direction.
-			playerObject[0].setTextureRect(lookLeft);
+			transforms.spriteRects[0] = TextureAtlas::subRect(marioWalkingSpritesheet, lookLeft);
 			//and animation loop through spritesheet.
 			if (elapsedTime > 0.5f)
 			{
@@ -582,8 +848,8 @@ void Game::animatePlayer()
 				} else {
 					lookLeft.left += 50;
 				}
-				playerObject[0].setTextureRect(lookLeft);
-				marioClock.restart();
+				transforms.spriteRects[0] = TextureAtlas::subRect(marioWalkingSpritesheet, lookLeft);
+				elapsedTime = 0.0f;
 			}
 			rightLast = false;
 		}
@@ -592,12 +858,11 @@ void Game::animatePlayer()
 	else if (isWalking == false)
 	{
 		if (rightLast == true) {
-			playerObject[0].setTextureRect(sf::IntRect(0, 0, 50, 50));
+			transforms.spriteRects[0] = TextureAtlas::subRect(marioIdle, sf::IntRect(0, 0, 50, 50));
 		}
 		else if (rightLast == false) {
-			playerObject[0].setTextureRect(sf::IntRect(50, 0, -50, 50));
+			transforms.spriteRects[0] = TextureAtlas::subRect(marioIdle, sf::IntRect(50, 0, -50, 50));
 		}
-		playerObject[0].setTexture(&marioIdle);
 	}
 }
 
@@ -622,7 +887,7 @@ void Game::fallenOffScreenCheck()
 void Game::playerDead()
 {
 	//play mario death sfx.
-	marioDeadSFX.play();
+	audio.play(AudioEngine::DEAD);
 
 	//take a life off the player.
 	lives--;
@@ -630,6 +895,11 @@ void Game::playerDead()
 	//send player to its last checkpoint spawn position and set impulses to 0 on body.
 	playerBody->SetTransform(currentCheckpoint, 0.0f);
 	playerBody->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+	//don't interpolate the render position across the respawn.
+	transforms.snap(0);
+
+	//stomped enemies come back with the lost life.
+	respawnEnemies();
 
 	//movement bools set so idle.
 	playerStop = true;
@@ -637,16 +907,138 @@ void Game::playerDead()
 	movingLeft = false;
 }
 
+//! Function to return where the camera is centred on x.
+/*!
+\param - n/a
+\return float - same centre as cameraController(), the player's x kept in the world's left boundary, but from the body so it works without rendering.
+*/
+float Game::cameraCentreX() const
+{
+	return std::max(playerObject[0].getBody()->GetPosition().x, 0.0f);
+}
+
+//! Function to find the edges of the camera plus a margin, and the items overlapping it from the spatial index.
+/*!
+\param - n/a
+*/
+void Game::cullToView()
+{
+	float centre = cameraCentreX();
+	float halfWidth = view.getSize().x * 0.5f + cullMargin;
+	visibleLeft = centre - halfWidth;
+	visibleRight = centre + halfWidth;
+	staticIndex.query(visibleLeft, visibleRight, visibleObjects);
+}
+
+//! Function to take the objects stomped or collected during the step out of the world, deactivating them in their pools.
+/*!
+\param - n/a
+\ Their slots are held until their chunk is torn down, so stomped enemies can respawn and collected coins are remembered.
+*/
+void Game::releaseRemoved()
+{
+	listener.collectRemovals(removedObjects);
+	for (const BodyTag& tag : removedObjects)
+	{
+		if (tag.kind == BodyTag::ITEM)
+		{
+			//items are static, so also come out of the spatial index with the bounds they went in with.
+			itemList[tag.index].despawn();
+			sf::FloatRect bounds = itemList[tag.index].getGlobalBounds();
+			staticIndex.remove(tag, bounds.left, bounds.left + bounds.width);
+			itemList.deactivate(tag.index);
+		}
+		else if (tag.kind == BodyTag::ENEMY)
+		{
+			enemyObject[tag.index].despawn();
+			enemyObject.deactivate(tag.index);
+		}
+	}
+}
+
+//! Function to bring every stomped enemy in the built chunks back at its spawn position, in the pool slot it was deactivated in.
+/*!
+\param - n/a
+*/
+void Game::respawnEnemies()
+{
+	bool respawned = false;
+	for (const ResidentChunk& chunk : residentChunks)
+	{
+		for (const BodyTag& tag : chunk.objects)
+		{
+			if (tag.kind == BodyTag::ENEMY && !enemyObject.isActive(tag.index))
+			{
+				//slots never move, so the enemy left in the slot still knows where it spawned.
+				enemyObject.reactivate(tag.index);
+				enemyObject[tag.index].spawn(enemyObject[tag.index].getSpawnPosition());
+				respawned = true;
+			}
+		}
+	}
+
+	//respawned enemies are asleep, so wake the window again from scratch.
+	if (respawned == true)
+	{
+		for (size_t i = firstAwakeEnemy; i < endAwakeEnemy; i++)
+		{
+			enemyObject[enemyWakeOrder[i]].deactivate();
+		}
+		firstAwakeEnemy = 0;
+		endAwakeEnemy = 0;
+		updateEnemyActivation();
+	}
+}
+
+//! Function to keep the enemies near the camera awake and the rest asleep, with inactive bodies.
+/*!
+\param - n/a
+\ The awake enemies are a window of enemyWakeOrder, so only enemies entering or leaving the window are touched.
+*/
+void Game::updateEnemyActivation()
+{
+	float centre = cameraCentreX();
+	float wakeEdge = centre + enemyWakeDistance;
+	float sleepEdge = centre - enemySleepDistance;
+
+	//wake enemies the camera has come near, ahead of it, and behind it after going back to a checkpoint.
+	while (endAwakeEnemy < enemyWakeOrder.size() && enemyObject[enemyWakeOrder[endAwakeEnemy]].getSpawnX() <= wakeEdge)
+	{
+		enemyObject[enemyWakeOrder[endAwakeEnemy]].activate();
+		//the body hasn't moved while asleep, so don't interpolate from wherever it was drawn last.
+		transforms.snap(firstEnemyTransform + endAwakeEnemy);
+		endAwakeEnemy++;
+	}
+	while (firstAwakeEnemy > 0 && enemyObject[enemyWakeOrder[firstAwakeEnemy - 1]].getSpawnX() >= sleepEdge)
+	{
+		firstAwakeEnemy--;
+		enemyObject[enemyWakeOrder[firstAwakeEnemy]].activate();
+		transforms.snap(firstEnemyTransform + firstAwakeEnemy);
+	}
+
+	//put to sleep those left far behind, and those far ahead after going back.
+	while (firstAwakeEnemy < endAwakeEnemy && enemyObject[enemyWakeOrder[firstAwakeEnemy]].getSpawnX() < sleepEdge)
+	{
+		enemyObject[enemyWakeOrder[firstAwakeEnemy]].deactivate();
+		firstAwakeEnemy++;
+	}
+	while (endAwakeEnemy > firstAwakeEnemy && enemyObject[enemyWakeOrder[endAwakeEnemy - 1]].getSpawnX() > wakeEdge)
+	{
+		endAwakeEnemy--;
+		enemyObject[enemyWakeOrder[endAwakeEnemy]].deactivate();
+	}
+}
+
 //! Function to link the camera to the motion of the player object but keep it constrained to the view.
 /*!
 \param - n/a
 */
 void Game::cameraController()
 {
-	//setting camera to follow the player.
+	//setting camera to follow the player's rendered position.
 	float yOffset = 0.65f;
 	float xBoundary = 0.0f;
-	view.setCenter(sf::Vector2f(playerBody->GetPosition().x, yOffset));
+	view.setCenter(sf::Vector2f(transforms.renderX[0], yOffset));
 
 	//setting a check as to camera position to out-of-world boundaries; keeps camera in world.
 	if (view.getCenter().x < xBoundary)
@@ -695,17 +1087,13 @@ void Game::completedLevel()
 void Game::checkpointMan()
 {
 	float currentPlayerPosition = playerBody->GetPosition().x;
-	//checking current player position to the checkpoints, as player passes them that checkpoint is set to the respawn checkpoint.
-	if (currentPlayerPosition >= checkpoint1 && currentPlayerPosition < checkpoint2 &&
-		currentPlayerPosition < checkpoint3 && currentPlayerPosition < checkpoint4) {
-		currentCheckpoint.x = checkpoint1;
-	} else if (currentPlayerPosition >= checkpoint2 && currentPlayerPosition < checkpoint3 &&
-		currentPlayerPosition < checkpoint4) {
-		currentCheckpoint.x = checkpoint2;
-	} else if (currentPlayerPosition >= checkpoint3 && currentPlayerPosition < checkpoint4) {
-		currentCheckpoint.x = checkpoint3;
-	} else if (currentPlayerPosition >= checkpoint4) {
-		currentCheckpoint.x = checkpoint4;
+	//checking current player position to the checkpoints, the furthest one the player has passed is set to the respawn checkpoint.
+	for (float checkpoint : checkpoints)
+	{
+		if (currentPlayerPosition >= checkpoint)
+		{
+			currentCheckpoint.x = checkpoint;
+		}
 	}
 }
 
@@ -739,253 +1127,434 @@ void Game::gameConditions()
 	}
 }
 
-//! Function to populate the world with all required objects.
+//collision category of each LevelEntity kind.
+static const uint16 levelCategoryBits[LevelEntity::KIND_COUNT] = {
+	PhysicalObject::CollisionFilter::PLAYER,			//player.
+	PhysicalObject::CollisionFilter::ENEMY,				//enemy.
+	PhysicalObject::CollisionFilter::ITEM,				//coin.
+	PhysicalObject::CollisionFilter::OBSTACLE,			//obstacle.
+	PhysicalObject::CollisionFilter::GROUND,			//ground.
+	PhysicalObject::CollisionFilter::BREAKABLE_BOX,		//platform.
+	0													//sensor, sets its own filter.
+};
+
+//what each LevelEntity kind collides with, each mask written only the once.
+static const uint16 levelMaskBits[LevelEntity::KIND_COUNT] = {
+	//player.
+	PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
+	PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
+	PhysicalObject::CollisionFilter::ITEM | PhysicalObject::CollisionFilter::OBSTACLE,
+	//enemy.
+	PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
+	PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
+	PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE,
+	//coin.
+	PhysicalObject::CollisionFilter::PLAYER,
+	//obstacle.
+	PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY,
+	//ground.
+	PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY,
+	//platform.
+	PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY,
+	//sensor, sets its own filter.
+	0
+};
+
+//! Function to return the atlas rect for a LevelEntity texture id.
+/*!
+\param uint8 texture - one of LevelEntity::Texture.
+\return sf::IntRect - the rect within the atlas, or an empty rect if the object has no texture.
+*/
+sf::IntRect Game::levelTextureRect(uint8 texture)
+{
+	switch (texture)
+	{
+	case LevelEntity::STONES: return stones;
+	case LevelEntity::BRICK_1X1: return brick1x1;
+	case LevelEntity::BRICK_2X1: return brick2x1;
+	case LevelEntity::BRICK_3X1: return brick3x1;
+	case LevelEntity::BRICK_4X1: return brick4x1;
+	case LevelEntity::SOLID_BLOCK: return solidBlock;
+	case LevelEntity::COIN_TEXTURE: return coin;
+	case LevelEntity::SMALL_TUBE: return smallTube;
+	case LevelEntity::BIG_TUBE: return bigTube;
+	case LevelEntity::FLAG: return flag;
+	case LevelEntity::GOOMBA: return goombaWalkingSpriteSheet;
+	case LevelEntity::MARIO: return marioWalkingSpritesheet;
+	default: return sf::IntRect();
+	}
+}
+
+//! Function to queue the level to load, populating the world with all required objects once it has, from the level file or generated.
+/*!
+\param std::string levelName - empty for world 1-1, "gen:..." or "scene:..." for a generated level, otherwise a cooked or text level file.
+*/
+void Game::populateWorld(const std::string& levelName)
+{
+	//the level is read or generated off the main thread, and built once the textures it is drawn with have loaded.
+	//Games playing the same level, such as a replay farm's, share the one copy of it.
+	std::string path = levelName.empty() ? "./assets/levels/world_01_01" : levelName;
+	loader.addShared<LevelData>("level", path, [levelName](LevelData& loading) {
+		bool loaded;
+		if (levelName.empty())
+		{
+			//open the cooked level to stream, falling back to the text description if it hasn't been cooked.
+			loaded = loading.openCooked("./assets/levels/world_01_01.lvl") || loading.loadText("./assets/levels/world_01_01.txt");
+		}
+		else if (levelName.compare(0, 4, "gen:") == 0 || levelName.compare(0, 6, "scene:") == 0)
+		{
+			loaded = LevelGenerator::fromSpec(levelName, loading);
+		}
+		else
+		{
+			//anything else is a level file, cooked unless it ends in .txt.
+			bool text = levelName.size() > 4 && levelName.compare(levelName.size() - 4, 4, ".txt") == 0;
+			loaded = text ? loading.loadText(levelName) : loading.openCooked(levelName);
+		}
+
+		//levels that weren't cooked in chunks are split here, and streamed from memory.
+		if (loaded == true && loading.chunkWidth <= 0.0f)
+		{
+			loading.buildChunks(LevelData::defaultChunkWidth);
+		}
+		return loaded;
+	}, [](LevelData& loading, bool decoded) {
+		//if the level doesn't load, play a generated one in its place.
+		if (decoded == false)
+		{
+			LevelGenerator generator;
+			generator.generate(GeneratorSettings(), loading);
+			loading.buildChunks(LevelData::defaultChunkWidth);
+		}
+	}, [this](std::shared_ptr<const LevelData> loaded) {
+		levelData = loaded;
+#ifndef HEADLESS
+		//chunks are read ahead of the camera on a thread of their own.
+		levelStream.open(levelData, true);
+#else
+		//headless steps as fast as it can, so each chunk is read as it is built.
+		levelStream.open(levelData, false);
+#endif
+		buildWorld(*levelData);
+		startLevel();
+	});
+}
+
+//! Function to create the players, then build the chunks of the level around the start, the rest are built as the camera nears them.
+/*!
+\param LevelData level - the level to build, already opened in levelStream.
+*/
+void Game::buildWorld(const LevelData& level)
+{
+	//init start co-ords in world, the end co-ords x-pos and the checkpoints.
+	startPosition = b2Vec2(level.startX, level.startY);
+	currentCheckpoint = startPosition;
+	endPosition = level.endPosition;
+	checkpoints = level.checkpoints;
+
+	//the players are the permanent entities at the start of the level, they are never streamed.
+	playerObject.reserve(level.permanentCount);
+	for (uint32_t i = 0; i < level.permanentCount; i++)
+	{
+		addObject(level.entities[i]);
+	}
+	transforms.clear();
+	for (const auto& player : playerObject)
+	{
+		transforms.add(player.getBody(), player.getSize(), player.getTextureRect());
+	}
+	firstEnemyTransform = transforms.size();
+
+	//the index only has to span the chunks built at once, it wraps around for the rest of the level.
+	staticIndex.build(level.chunkOrigin, level.chunkOrigin + chunkKeepDistance * 2.0f + level.chunkWidth * 2.0f, indexCellWidth);
+	collectedItems.assign(level.totalEntities(), false);
+
+	//build the chunks around the start, read straight away as nothing has been read ahead yet.
+	residentChunks.clear();
+	enemyWakeOrder.clear();
+	firstAwakeEnemy = 0;
+	endAwakeEnemy = 0;
+	streamChunks();
+	cullToView();
+}
+
+//! Function to create one level object in the world, in a free slot of its pool, and tag its body with where it went.
+/*!
+\param LevelEntity entity - the object to create.
+\return BodyTag - its kind and slot.
+*/
+BodyTag Game::addObject(const LevelEntity& entity)
+{
+	sf::Vector2f position(entity.x, entity.y);
+	sf::Vector2f size(entity.width, entity.height);
+	uint16 categoryBits = levelCategoryBits[entity.kind];
+	uint16 maskBits = levelMaskBits[entity.kind];
+	const sf::Texture* texture = entity.texture == LevelEntity::NO_TEXTURE ? nullptr : atlas->getTexture();
+	sf::IntRect textureRect = levelTextureRect(entity.texture);
+
+	BodyTag tag = { BodyTag::NONE, 0 };
+	switch (entity.kind)
+	{
+	case LevelEntity::PLAYER:
+		playerObject.push_back(Player(world, position, size, 0.0f, categoryBits, maskBits, texture, &marioSprite, 4, 0.25f));
+		playerObject.back().setTextureRect(TextureAtlas::subRect(textureRect, playerObject.back().getTextureRect()));
+		//tagged by startLevel, with the rest of the players.
+		return { BodyTag::PLAYER, (uint16)(playerObject.size() - 1) };
+	case LevelEntity::ENEMY:
+		tag = { BodyTag::ENEMY, enemyObject.place(Enemy(world, position, size, 0.0f, categoryBits, maskBits, texture, &goombaSprite, 2, 1.0f)) };
+		enemyObject[tag.index].setTextureRect(TextureAtlas::subRect(textureRect, enemyObject[tag.index].getTextureRect()));
+		enemyObject[tag.index].setTag(tag);
+		break;
+	case LevelEntity::COIN:
+		tag = { BodyTag::ITEM, itemList.place(Item(world, position, size, 0.0f, categoryBits, maskBits, texture)) };
+		itemList[tag.index].setTextureRect(textureRect);
+		itemList[tag.index].setTag(tag);
+		break;
+	case LevelEntity::OBSTACLE:
+		//obstacles and blocks are only drawn, buildChunk() merges their collision into the chunk's StaticGeometry.
+		tag = { BodyTag::OBSTACLE, obstaclesList.place(Obstacle(position, size, texture)) };
+		obstaclesList[tag.index].setTextureRect(textureRect);
+		break;
+	case LevelEntity::GROUND:
+	case LevelEntity::PLATFORM:
+		tag = { BodyTag::GROUND, staticBlock.place(StaticRect(position, size, texture)) };
+		staticBlock[tag.index].setTextureRect(textureRect);
+		break;
+	case LevelEntity::SENSOR:
+		tag = { BodyTag::SENSOR, staticSensors.place(StaticSensor(world, position, size, 0.0f)) };
+		staticSensors[tag.index].setTag(tag);
+		break;
+	}
+
+	//items go in the index along x, with the bounds removeObject() takes them out with, blocks and obstacles are baked into their chunk instead.
+	if (tag.kind == BodyTag::ITEM)
+	{
+		sf::FloatRect bounds = itemList[tag.index].getGlobalBounds();
+		staticIndex.insert(tag, bounds.left, bounds.left + bounds.width);
+	}
+	return tag;
+}
+
+//! Function to destroy one level object's body, if it has its own, take it out of the index and release its slot for the next chunk built.
+/*!
+\param BodyTag tag - the object.
+*/
+void Game::removeObject(BodyTag tag)
+{
+	switch (tag.kind)
+	{
+	case BodyTag::GROUND:
+		staticBlock.release(tag.index);
+		break;
+	case BodyTag::ITEM:
+	{
+		//collected items already came out of the index.
+		if (itemList.isActive(tag.index))
+		{
+			sf::FloatRect bounds = itemList[tag.index].getGlobalBounds();
+			staticIndex.remove(tag, bounds.left, bounds.left + bounds.width);
+		}
+		world->DestroyBody(itemList[tag.index].getBody());
+		itemList.release(tag.index);
+		break;
+	}
+	case BodyTag::OBSTACLE:
+		obstaclesList.release(tag.index);
+		break;
+	case BodyTag::ENEMY:
+		world->DestroyBody(enemyObject[tag.index].getBody());
+		enemyObject.release(tag.index);
+		break;
+	case BodyTag::SENSOR:
+		world->DestroyBody(staticSensors[tag.index].getBody());
+		staticSensors.release(tag.index);
+		break;
+	}
+}
+
+//! Function to build the chunks the camera has come near and tear down those it has left far behind, keeping the built chunks one contiguous run.
+/*!
+\param - n/a
+\ Chunks are built a little further out than enemies wake and torn down further out still, so an object is never built and torn down on alternate steps.
+\ Everything here follows the player body, not the render, so a replay builds and tears down the same chunks on the same steps.
+*/
+void Game::streamChunks()
+{
+	const LevelData& level = *levelData;
+	float centre = cameraCentreX();
+	int buildFirst = level.firstChunkReaching(centre - chunkBuildBehind);
+	int buildEnd = level.chunkEnd(centre + chunkBuildAhead);
+	int keepFirst = level.firstChunkReaching(centre - chunkKeepDistance);
+	int keepEnd = level.chunkEnd(centre + chunkKeepDistance);
+	bool changed = false;
+
+	//tear down the chunks left behind, and those far ahead after going back to a checkpoint.
+	while (!residentChunks.empty() && residentChunks.front().index < keepFirst)
+	{
+		tearDownChunk(residentChunks.front());
+		residentChunks.pop_front();
+		changed = true;
+	}
+	while (!residentChunks.empty() && residentChunks.back().index >= keepEnd)
+	{
+		tearDownChunk(residentChunks.back());
+		residentChunks.pop_back();
+		changed = true;
+	}
+
+	//build the chunks the camera has come near, at whichever end of the run they are.
+	size_t kept = residentChunks.size();
+	if (buildFirst < buildEnd)
+	{
+		if (residentChunks.empty())
+		{
+			buildChunk(buildFirst, false);
+		}
+		while (residentChunks.front().index > buildFirst)
+		{
+			buildChunk(residentChunks.front().index - 1, true);
+		}
+		while (residentChunks.back().index + 1 < buildEnd)
+		{
+			buildChunk(residentChunks.back().index + 1, false);
+		}
+		changed = changed || residentChunks.size() != kept;
+	}
+
+	//read the next chunks ahead in the background, and drop any read that won't be built now.
+	int readFirst = residentChunks.empty() ? buildEnd : residentChunks.back().index + 1;
+	int readEnd = level.chunkEnd(centre + chunkReadAhead);
+	levelStream.forget(keepFirst, readEnd);
+	for (int chunk = readFirst; chunk < readEnd; chunk++)
+	{
+		levelStream.prefetch(chunk);
+	}
+
+	if (changed == true)
+	{
+		orderEnemies();
+	}
+}
+
+//! Function to build a chunk's objects into the world, skipping coins already collected, and add it at one end of the resident run.
+/*!
+\param int index - which chunk.
+\param bool atFront - whether it goes before the run, otherwise after it.
+\ The chunk's ground blocks and obstacles are merged into one body of outlines, rather than a body each,
+\ and baked into vertices by texture once here, as they never move.
+*/
+void Game::buildChunk(int index, bool atFront)
+{
+	std::unique_ptr<LevelStream::Chunk> chunk = levelStream.take(index);
+	ResidentChunk resident;
+	resident.index = index;
+	uint32_t firstEntity = levelData->chunks[index].firstEntity;
+	for (size_t i = 0; i < chunk->entities.size(); i++)
+	{
+		uint32_t entity = firstEntity + (uint32_t)i;
+		if (chunk->entities[i].kind == LevelEntity::COIN && collectedItems[entity] == true)
+		{
+			continue;
+		}
+		const LevelEntity& object = chunk->entities[i];
+		BodyTag tag = addObject(object);
+		resident.objects.push_back(tag);
+		resident.entities.push_back(entity);
+		if (tag.kind == BodyTag::GROUND || tag.kind == BodyTag::OBSTACLE)
+		{
+			sf::FloatRect bounds(object.x - object.width * 0.5f, object.y - object.height * 0.5f, object.width, object.height);
+			resident.geometry.add(tag, bounds, levelCategoryBits[object.kind], levelMaskBits[object.kind]);
+			if (tag.kind == BodyTag::GROUND) resident.ground.add(staticBlock[tag.index]);
+			else resident.obstacles.add(obstaclesList[tag.index]);
+			resident.left = std::min(resident.left, bounds.left);
+			resident.right = std::max(resident.right, bounds.left + bounds.width);
+		}
+	}
+	resident.geometry.build(world);
+
+	//the chunk read is done with, only what was built from it is kept.
+	if (atFront == true)
+	{
+		residentChunks.push_front(std::move(resident));
+	}
+	else
+	{
+		residentChunks.push_back(std::move(resident));
+	}
+}
+
+//! Function to take every object a chunk built out of the world, remembering which of its coins were collected.
+/*!
+\param ResidentChunk chunk - the chunk.
+*/
+void Game::tearDownChunk(ResidentChunk& chunk)
+{
+	//the merged body goes first, its fixtures are tagged with the blocks released below.
+	chunk.geometry.destroy(world);
+	for (size_t i = 0; i < chunk.objects.size(); i++)
+	{
+		const BodyTag& tag = chunk.objects[i];
+		if (tag.kind == BodyTag::ITEM && !itemList.isActive(tag.index))
+		{
+			collectedItems[chunk.entities[i]] = true;
+		}
+		removeObject(tag);
+	}
+}
+
+//! Function to rebuild the enemy wake order and the enemies' transforms from the built chunks, after chunks are built or torn down.
 /*!
 \param - n/a
+\ The window woken is the one updateEnemyActivation() keeps, so enemies already awake stay awake and carry on undisturbed.
 */
-void Game::populateWorld()
-{
-	//adding a sensor object into world, to be used by contact listener.
-	staticSensors.push_back(StaticSensor(world, sf::Vector2f(-3.0f, -3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f));
-
-	//add the player to the world.
-	playerObject.resize(1);
-	playerObject[0] = Player(world, sf::Vector2f(-3.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::PLAYER,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::ITEM | PhysicalObject::CollisionFilter::OBSTACLE, &marioWalkingSpritesheet, &marioSprite, 4, 0.25f);
-
-	//adding the enemies into the world.
-	enemyObject.resize(12);
-	enemyObject[0] = Enemy(world, sf::Vector2f(1.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[1] = Enemy(world, sf::Vector2f(14.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[2] = Enemy(world, sf::Vector2f(19.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[3] = Enemy(world, sf::Vector2f(24.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[4] = Enemy(world, sf::Vector2f(28.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[5] = Enemy(world, sf::Vector2f(38.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[6] = Enemy(world, sf::Vector2f(53.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[7] = Enemy(world, sf::Vector2f(67.5f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[8] = Enemy(world, sf::Vector2f(80.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[9] = Enemy(world, sf::Vector2f(91.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[10] = Enemy(world, sf::Vector2f(106.5f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-	enemyObject[11] = Enemy(world, sf::Vector2f(116.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY,
-		PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::BOUNDARY | PhysicalObject::CollisionFilter::BREAKABLE_BOX |
-		PhysicalObject::CollisionFilter::UNBREAKABLE_BOX | PhysicalObject::CollisionFilter::CHEST_BOX | PhysicalObject::CollisionFilter::ENEMY |
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::OBSTACLE, &goombaWalkingSpriteSheet, &goombaSprite, 2, 1.0f);
-
-	//adding items into the world.
-	itemList.resize(45);
-	itemList[0] = Item(world, sf::Vector2f(0.5f, 1.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[1] = Item(world, sf::Vector2f(1.5f, 1.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[2] = Item(world, sf::Vector2f(4.5f, 0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[3] = Item(world, sf::Vector2f(7.5f, -1.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[4] = Item(world, sf::Vector2f(8.0f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[5] = Item(world, sf::Vector2f(9.0f, 1.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[6] = Item(world, sf::Vector2f(13.0f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[7] = Item(world, sf::Vector2f(14.0f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[8] = Item(world, sf::Vector2f(18.5f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[9] = Item(world, sf::Vector2f(19.5f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[10] = Item(world, sf::Vector2f(22.0f, 0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[11] = Item(world, sf::Vector2f(22.0f, 0.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[12] = Item(world, sf::Vector2f(22.0f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[13] = Item(world, sf::Vector2f(23.5f, -1.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[14] = Item(world, sf::Vector2f(24.5f, -1.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[15] = Item(world, sf::Vector2f(27.0f, -2.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[16] = Item(world, sf::Vector2f(38.5f, 1.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[17] = Item(world, sf::Vector2f(41.5f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[18] = Item(world, sf::Vector2f(44.0f, -1.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[19] = Item(world, sf::Vector2f(47.5f, -1.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[20] = Item(world, sf::Vector2f(48.5f, -1.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[21] = Item(world, sf::Vector2f(52.5f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[22] = Item(world, sf::Vector2f(53.5f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[23] = Item(world, sf::Vector2f(64.0f, 0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[24] = Item(world, sf::Vector2f(64.0f, 0.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[25] = Item(world, sf::Vector2f(64.0f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[26] = Item(world, sf::Vector2f(65.5f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[27] = Item(world, sf::Vector2f(66.5f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[28] = Item(world, sf::Vector2f(72.5f, 1.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[29] = Item(world, sf::Vector2f(73.5f, 0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[30] = Item(world, sf::Vector2f(74.5f, 1.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[31] = Item(world, sf::Vector2f(79.5f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[32] = Item(world, sf::Vector2f(80.5f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[33] = Item(world, sf::Vector2f(96.0f, 0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[34] = Item(world, sf::Vector2f(96.0f, 0.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[35] = Item(world, sf::Vector2f(96.0f, -0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[36] = Item(world, sf::Vector2f(107.0f, 0.5f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[37] = Item(world, sf::Vector2f(104.5f, -1.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[38] = Item(world, sf::Vector2f(103.5f, -1.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[39] = Item(world, sf::Vector2f(115.5f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[40] = Item(world, sf::Vector2f(116.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[41] = Item(world, sf::Vector2f(116.5f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[42] = Item(world, sf::Vector2f(117.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[43] = Item(world, sf::Vector2f(117.5f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-	itemList[44] = Item(world, sf::Vector2f(118.0f, 3.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ITEM,
-		PhysicalObject::CollisionFilter::PLAYER, &coin);
-
-	//adding obstacles into the world.
-	obstaclesList.resize(14);
-	obstaclesList[0] = Obstacle(world, sf::Vector2f(12.0f, 2.8f), sf::Vector2f(1.5f, 1.0f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &smallTube);
-	obstaclesList[1] = Obstacle(world, sf::Vector2f(16.0f, 2.8f), sf::Vector2f(1.5f, 1.0f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &smallTube);
-	obstaclesList[2] = Obstacle(world, sf::Vector2f(36.0f, 2.8f), sf::Vector2f(1.5f, 1.0f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &smallTube);
-	obstaclesList[3] = Obstacle(world, sf::Vector2f(48.0f, 2.8f), sf::Vector2f(1.5f, 1.0f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &smallTube);
-	obstaclesList[4] = Obstacle(world, sf::Vector2f(71.0f, 2.8f), sf::Vector2f(1.5f, 1.0f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &smallTube);
-	obstaclesList[5] = Obstacle(world, sf::Vector2f(76.0f, 2.8f), sf::Vector2f(1.5f, 1.0f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &smallTube);
-	obstaclesList[6] = Obstacle(world, sf::Vector2f(103.0f, 2.8f), sf::Vector2f(1.5f, 1.0f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &smallTube);
-	obstaclesList[7] = Obstacle(world, sf::Vector2f(110.0f, 2.8f), sf::Vector2f(1.5f, 1.0f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &smallTube);
-	obstaclesList[8] = Obstacle(world, sf::Vector2f(22.0f, 2.38f), sf::Vector2f(1.5f, 1.8f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &bigTube);
-	obstaclesList[9] = Obstacle(world, sf::Vector2f(30.0f, 2.38f), sf::Vector2f(1.5f, 1.8f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &bigTube);
-	obstaclesList[10] = Obstacle(world, sf::Vector2f(51.0f, 2.38f), sf::Vector2f(1.5f, 1.8f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &bigTube);
-	obstaclesList[11] = Obstacle(world, sf::Vector2f(64.0f, 2.38f), sf::Vector2f(1.5f, 1.8f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &bigTube);
-	obstaclesList[12] = Obstacle(world, sf::Vector2f(83.0f, 2.38f), sf::Vector2f(1.5f, 1.8f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &bigTube);
-	obstaclesList[13] = Obstacle(world, sf::Vector2f(96.0f, 2.38f), sf::Vector2f(1.5f, 1.8f), 0.0f, PhysicalObject::CollisionFilter::OBSTACLE,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &bigTube);
-
-	//adding ground blocks into the world.
-	staticBlock.resize(27);
-	staticBlock[0] = StaticRect(world, sf::Vector2f(0.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[1] = StaticRect(world, sf::Vector2f(14.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[2] = StaticRect(world, sf::Vector2f(26.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[3] = StaticRect(world, sf::Vector2f(38.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[4] = StaticRect(world, sf::Vector2f(52.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[5] = StaticRect(world, sf::Vector2f(66.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[6] = StaticRect(world, sf::Vector2f(78.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[7] = StaticRect(world, sf::Vector2f(92.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[8] = StaticRect(world, sf::Vector2f(106.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[9] = StaticRect(world, sf::Vector2f(118.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[10] = StaticRect(world, sf::Vector2f(130.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-	staticBlock[11] = StaticRect(world, sf::Vector2f(142.0f, 4.29f), sf::Vector2f(12.0f, 2.0f), 0.0f, PhysicalObject::CollisionFilter::GROUND,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &stones);
-
-	//adding the platforms
-	staticBlock[12] = StaticRect(world, sf::Vector2f(1.0f, 2.0f), sf::Vector2f(2.0f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick4x1);
-	staticBlock[13] = StaticRect(world, sf::Vector2f(4.5f, 1.0f), sf::Vector2f(1.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick3x1);
-	staticBlock[14] = StaticRect(world, sf::Vector2f(13.5f, 0.0f), sf::Vector2f(2.0f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick4x1);
-	staticBlock[15] = StaticRect(world, sf::Vector2f(19.0f, 0.0f), sf::Vector2f(1.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick3x1);
-	staticBlock[16] = StaticRect(world, sf::Vector2f(24.0f, -0.5f), sf::Vector2f(2.0f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick4x1);
-	staticBlock[17] = StaticRect(world, sf::Vector2f(27.0f, -2.0f), sf::Vector2f(1.0f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick2x1);
-	staticBlock[18] = StaticRect(world, sf::Vector2f(38.5f, 1.5f), sf::Vector2f(1.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick3x1);
-	staticBlock[19] = StaticRect(world, sf::Vector2f(48.0f, -1.0f), sf::Vector2f(1.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick3x1);
-	staticBlock[20] = StaticRect(world, sf::Vector2f(53.0f, 0.0f), sf::Vector2f(2.0f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick4x1);
-	staticBlock[21] = StaticRect(world, sf::Vector2f(66.0f, 0.0f), sf::Vector2f(2.0f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick4x1);
-	staticBlock[22] = StaticRect(world, sf::Vector2f(80.0f, 0.0f), sf::Vector2f(2.0f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick4x1);
-	staticBlock[23] = StaticRect(world, sf::Vector2f(104.0f, -0.5f), sf::Vector2f(1.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick3x1);
-	staticBlock[24] = StaticRect(world, sf::Vector2f(107.0f, 1.0f), sf::Vector2f(1.0f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick2x1);
-	staticBlock[25] = StaticRect(world, sf::Vector2f(41.5, 0.0f), sf::Vector2f(1.0f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick2x1);
-	staticBlock[26] = StaticRect(world, sf::Vector2f(44.0f, -1.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::BREAKABLE_BOX,
-		PhysicalObject::CollisionFilter::PLAYER | PhysicalObject::CollisionFilter::ENEMY, &brick1x1);
-}
\ No newline at end of file
+void Game::orderEnemies()
+{
+	//every enemy in the built chunks, stomped ones too as they respawn, ordered by where they start.
+	enemyWakeOrder.clear();
+	for (const ResidentChunk& chunk : residentChunks)
+	{
+		for (const BodyTag& tag : chunk.objects)
+		{
+			if (tag.kind == BodyTag::ENEMY)
+			{
+				enemyWakeOrder.push_back(tag.index);
+			}
+		}
+	}
+	std::sort(enemyWakeOrder.begin(), enemyWakeOrder.end(), [&](uint16 a, uint16 b) {
+		return enemyObject[a].getSpawnX() < enemyObject[b].getSpawnX();
+	});
+
+	//the enemies' transforms follow the players', in wake order.
+	transforms.truncate(firstEnemyTransform);
+	for (uint16 slot : enemyWakeOrder)
+	{
+		transforms.add(enemyObject[slot].getBody(), enemyObject[slot].getSize(), enemyObject[slot].getTextureRect());
+	}
+
+	//the awake window is those starting between the sleep and wake edges.
+	float centre = cameraCentreX();
+	float wakeEdge = centre + enemyWakeDistance;
+	float sleepEdge = centre - enemySleepDistance;
+	firstAwakeEnemy = 0;
+	while (firstAwakeEnemy < enemyWakeOrder.size() && enemyObject[enemyWakeOrder[firstAwakeEnemy]].getSpawnX() < sleepEdge)
+	{
+		firstAwakeEnemy++;
+	}
+	endAwakeEnemy = firstAwakeEnemy;
+	while (endAwakeEnemy < enemyWakeOrder.size() && enemyObject[enemyWakeOrder[endAwakeEnemy]].getSpawnX() <= wakeEdge)
+	{
+		endAwakeEnemy++;
+	}
+	for (size_t i = 0; i < enemyWakeOrder.size(); i++)
+	{
+		if (i >= firstAwakeEnemy && i < endAwakeEnemy)
+		{
+			enemyObject[enemyWakeOrder[i]].activate();
+		}
+		else
+		{
+			enemyObject[enemyWakeOrder[i]].deactivate();
+		}
+	}
+}
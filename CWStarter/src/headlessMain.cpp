@@ -0,0 +1,173 @@
+/*! \file headlessMain.cpp
+\brief Contains the entry point for the headless simulation build (CWStarterHeadless).
+* Steps the game rules and the Box2D world as fast as possible, with no window, textures, fonts or audio device.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "game.h"
+#include "inputRecording.h"
+#include "replayFarm.h"
+#include "tracer.h"
+
+//! Function to replay every recording under a path across the cores and report any whose outcome has changed.
+/*!
+\param std::string path - directory of .cwin recordings, or one recording.
+\param unsigned threads - worker threads, 0 for one per core.
+\param bool bless - store each replay's outcome as the expected one instead of checking it.
+\return int - exit code, 1 if any recording failed to load or didn't match.
+*/
+static int verifyReplays(const std::string& path, unsigned threads, bool bless)
+{
+	std::vector<std::string> fileNames = ReplayFarm::findRecordings(path);
+	auto start = std::chrono::high_resolution_clock::now();
+	std::vector<ReplayResult> results = ReplayFarm::run(fileNames, threads, bless);
+	auto end = std::chrono::high_resolution_clock::now();
+
+	int failed = 0;
+	int unchecked = 0;
+	uint64_t steps = 0;
+	for (const ReplayResult& result : results)
+	{
+		steps += result.steps;
+		if (result.passed() == false)
+		{
+			failed++;
+			if (result.loaded == true)
+			{
+				std::cout << "MISMATCH " << result.fileName << " expected score " << result.expected.score << " lives " << result.expected.lives << " completed at " << result.expected.completionStep
+					<< ", got score " << result.actual.score << " lives " << result.actual.lives << " completed at " << result.actual.completionStep << std::endl;
+			}
+			else
+			{
+				std::cout << "FAILED " << result.fileName << " did not load" << std::endl;
+			}
+		}
+		else if (result.hasExpected == false)
+		{
+			unchecked++;
+		}
+	}
+
+	double seconds = std::chrono::duration<double>(end - start).count();
+	std::cout << results.size() << " replays, " << failed << " failed, " << unchecked << " without an outcome to check (use --bless)" << std::endl;
+	std::cout << "Replayed " << steps << " steps in " << seconds << "s (" << (results.size() / seconds) << " replays, " << (steps / seconds) << " steps per second)" << std::endl;
+	return failed > 0 ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) /** Entry point for the headless simulation, takes a frame count or --replay <file>, and --level <file or spec> and --trace <file>. Or --verify <path> [--threads n] [--bless] */
+{
+	//number of frames to simulate, can be passed as an argument.
+	//or replay a recording made with the windowed build's --record, for as many steps as it ran.
+	//--trace captures the whole run to a trace file, --level plays another level, a generated one to measure how the cost scales.
+	int frameCount = 10000;
+	InputRecording recording;
+	InputReplay replay;
+	bool replaying = false;
+	std::string traceFile;
+	std::string levelName;
+	//--verify replays a directory of recordings on every core, checking each ends as it was recorded to.
+	std::string verifyPath;
+	unsigned threads = 0;
+	bool bless = false;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string option = argv[i];
+		if (option == "--replay" && i + 1 < argc)
+		{
+			if (!recording.load(argv[++i]))
+			{
+				return 1;
+			}
+			replay.start(&recording);
+			replaying = true;
+			frameCount = (int)recording.stepCount;
+		}
+		else if (option == "--trace" && i + 1 < argc)
+		{
+			traceFile = argv[++i];
+		}
+		else if (option == "--level" && i + 1 < argc)
+		{
+			levelName = argv[++i];
+		}
+		else if (option == "--verify" && i + 1 < argc)
+		{
+			verifyPath = argv[++i];
+		}
+		else if (option == "--threads" && i + 1 < argc)
+		{
+			threads = (unsigned)std::atoi(argv[++i]);
+		}
+		else if (option == "--bless")
+		{
+			bless = true;
+		}
+		else
+		{
+			frameCount = std::atoi(argv[i]);
+		}
+	}
+
+	if (!verifyPath.empty())
+	{
+		return verifyReplays(verifyPath, threads, bless);
+	}
+
+	//a replay plays the level it was recorded on, unless told otherwise.
+	if (replaying == true && levelName.empty())
+	{
+		levelName = recording.levelName;
+	}
+
+	//reference to the game class, built without any textures, fonts or audio.
+	Game game(levelName);
+
+	//the same fixed step the windowed build runs at, 60 per second.
+	const float frameTime = 1.0f / 60.0f;
+
+	//without a recording, hold right so the player runs through the level.
+	if (replaying == false)
+	{
+		game.userInput(sf::Keyboard::Right);
+	}
+
+#ifdef TRACING
+	if (!traceFile.empty())
+	{
+		Tracer::start();
+	}
+#endif
+
+	//step the game as fast as the CPU allows, until out of frames or the game is over.
+	auto start = std::chrono::high_resolution_clock::now();
+	int frame = 0;
+	while (frame < frameCount && game.gameOver == false)
+	{
+		//each step is a frame span in a trace, with the update stages nested in it.
+		TRACE_SCOPE("frame", "frame");
+		if (replaying == true)
+		{
+			replay.feed(game, frame);
+		}
+		game.update(frameTime);
+		game.endFrame();
+		frame++;
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	//report how quickly the frames were simulated and the final outcome.
+	double seconds = std::chrono::duration<double>(end - start).count();
+	std::cout << "Simulated " << frame << " frames in " << seconds << "s (" << (frame / seconds) << " frames per second)" << std::endl;
+	std::cout << "Score: " << game.getScore() << " Lives: " << game.getLives() << std::endl;
+
+	if (Tracer::isCapturing() == true)
+	{
+		Tracer::stop(traceFile);
+	}
+
+	return 0;
+}
@@ -0,0 +1,64 @@
+#include "hudText.h"
+#include <cstdio>
+
+/*! \file hudText.cpp
+* \brief Contains functions for HUD text that is only reformatted when the value it shows changes.
+*/
+
+//! Function to set the text shown before the number, showing it straight away.
+/*!
+\param const char* newLabel - the label, a string literal or other string that outlives the text.
+*/
+void HudText::setLabel(const char* newLabel)
+{
+	label = newLabel;
+	show();
+}
+
+//! Function to show a number after the label, doing nothing if it is already shown.
+/*!
+\param int newValue - the number.
+*/
+void HudText::setValue(int newValue)
+{
+	if (shown == true && message == nullptr && value == newValue)
+	{
+		return;
+	}
+	value = newValue;
+	message = nullptr;
+	show();
+}
+
+//! Function to show a message after the label in place of the number, doing nothing if it is already shown.
+/*!
+\param const char* newMessage - the message, a string literal or other string that outlives the text.
+*/
+void HudText::setMessage(const char* newMessage)
+{
+	if (shown == true && message == newMessage)
+	{
+		return;
+	}
+	message = newMessage;
+	show();
+}
+
+//! Function to format what is shown into the buffer and set it as the string, the only place the glyphs are rebuilt.
+/*!
+\param - n/a
+*/
+void HudText::show()
+{
+	if (message == nullptr)
+	{
+		std::snprintf(buffer, sizeof(buffer), "%s%d", label, value);
+	}
+	else
+	{
+		std::snprintf(buffer, sizeof(buffer), "%s%s", label, message);
+	}
+	setString(buffer);
+	shown = true;
+	rebuilds++;
+}
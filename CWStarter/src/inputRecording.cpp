@@ -0,0 +1,237 @@
+#include "inputRecording.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include "game.h"
+
+/*! \file inputRecording.cpp
+* \brief Contains functions to record key input against the physics step, save and load it compactly, and replay it into the game.
+*/
+
+//magic at the start of every recording file.
+static const char recordingMagic[4] = { 'C', 'W', 'I', 'N' };
+
+//! Function to append an unsigned value as a varint, 7 bits per byte with the top bit set on all but the last byte.
+/*!
+\param std::string out - buffer to append to.
+\param uint32_t value - the value to write.
+*/
+static void writeVarint(std::string& out, uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back((char)((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	out.push_back((char)value);
+}
+
+//! Function to read a varint written by writeVarint.
+/*!
+\param std::string in - buffer to read from.
+\param size_t pos - position to read at, moved past the value.
+\param uint32_t value - set to the value read.
+\return bool - false if the buffer ran out or the value is too long.
+*/
+static bool readVarint(const std::string& in, size_t& pos, uint32_t& value)
+{
+	value = 0;
+	for (int shift = 0; shift < 35; shift += 7)
+	{
+		if (pos >= in.size())
+		{
+			return false;
+		}
+		uint8_t byte = (uint8_t)in[pos++];
+		value |= (uint32_t)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//! Function to empty the recording.
+/*!
+\param - n/a
+*/
+void InputRecording::clear()
+{
+	stepCount = 0;
+	levelName.clear();
+	hasOutcome = false;
+	outcome = ReplayOutcome();
+	events.clear();
+}
+
+//! Function to add a key press or release, applied before the given physics step.
+/*!
+\param uint32_t step - how many physics steps had been taken when the input was applied.
+\param sf::Keyboard::Key key - the key.
+\param bool pressed - true for a press, false for a release.
+*/
+void InputRecording::record(uint32_t step, sf::Keyboard::Key key, bool pressed)
+{
+	//unknown keys have nothing to replay.
+	if (key < 0 || key >= 0x80)
+	{
+		return;
+	}
+	events.push_back({ step, (uint8_t)key, pressed });
+}
+
+//! Function to write the recording, events are delta encoded against the previous event's step.
+/*!
+\param std::string fileName - file to write.
+\return bool - whether the file was written.
+*/
+bool InputRecording::save(const std::string& fileName) const
+{
+	std::string data(recordingMagic, sizeof(recordingMagic));
+	data.push_back((char)version);
+	writeVarint(data, stepCount);
+	writeVarint(data, (uint32_t)levelName.size());
+	data += levelName;
+	writeVarint(data, hasOutcome ? 1 : 0);
+	if (hasOutcome == true)
+	{
+		writeVarint(data, (uint32_t)outcome.score);
+		writeVarint(data, (uint32_t)outcome.lives);
+		writeVarint(data, (uint32_t)(outcome.completionStep + 1));
+	}
+	writeVarint(data, (uint32_t)events.size());
+	uint32_t lastStep = 0;
+	for (const InputEvent& event : events)
+	{
+		writeVarint(data, event.step - lastStep);
+		data.push_back((char)((event.key << 1) | (event.pressed ? 1 : 0)));
+		lastStep = event.step;
+	}
+
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file.write(data.data(), data.size()))
+	{
+		std::cout << "recording " + fileName + " not saved" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+//! Function to read a recording written by save().
+/*!
+\param std::string fileName - file to read.
+\return bool - whether the file was read and valid.
+*/
+bool InputRecording::load(const std::string& fileName)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "recording " + fileName + " not found" << std::endl;
+		return false;
+	}
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	clear();
+	size_t pos = sizeof(recordingMagic) + 1;
+	uint32_t eventCount = 0;
+	uint8_t fileVersion = data.size() >= pos ? (uint8_t)data[sizeof(recordingMagic)] : 0;
+	bool valid = data.size() >= pos && data.compare(0, sizeof(recordingMagic), recordingMagic, sizeof(recordingMagic)) == 0
+		&& fileVersion >= 1 && fileVersion <= version
+		&& readVarint(data, pos, stepCount);
+
+	//version 2 added the level name and the outcome.
+	if (valid && fileVersion >= 2)
+	{
+		uint32_t nameLength = 0;
+		uint32_t flag = 0;
+		valid = readVarint(data, pos, nameLength) && nameLength <= data.size() - pos;
+		if (valid)
+		{
+			levelName = data.substr(pos, nameLength);
+			pos += nameLength;
+			valid = readVarint(data, pos, flag);
+		}
+		hasOutcome = valid && flag != 0;
+		if (hasOutcome == true)
+		{
+			uint32_t score, lives, completion;
+			valid = readVarint(data, pos, score) && readVarint(data, pos, lives) && readVarint(data, pos, completion);
+			outcome.score = (int32_t)score;
+			outcome.lives = (int32_t)lives;
+			outcome.completionStep = (int32_t)completion - 1;
+		}
+	}
+	valid = valid && readVarint(data, pos, eventCount);
+
+	//each event is at least two bytes, so a bad count can't make us reserve a huge list.
+	valid = valid && eventCount <= (data.size() - pos) / 2;
+	if (valid)
+	{
+		events.reserve(eventCount);
+	}
+
+	uint32_t step = 0;
+	for (uint32_t i = 0; valid && i < eventCount; i++)
+	{
+		uint32_t delta;
+		valid = readVarint(data, pos, delta) && pos < data.size();
+		if (valid)
+		{
+			uint8_t keyByte = (uint8_t)data[pos++];
+			step += delta;
+			events.push_back({ step, (uint8_t)(keyByte >> 1), (keyByte & 1) != 0 });
+		}
+	}
+
+	if (!valid)
+	{
+		std::cout << "recording " + fileName + " is not a valid recording, up to version " << (int)version << std::endl;
+		clear();
+		return false;
+	}
+	return true;
+}
+
+//! Function to start replaying a recording from its first event.
+/*!
+\param InputRecording source - the recording to replay, must outlive the replay.
+*/
+void InputReplay::start(const InputRecording* source)
+{
+	recording = source;
+	nextEvent = 0;
+}
+
+//! Function to feed the game every input that was applied before this physics step, through the same calls as window events.
+/*!
+\param Game game - the game to feed.
+\param uint32_t step - how many physics steps the game has taken.
+*/
+void InputReplay::feed(Game& game, uint32_t step)
+{
+	while (recording != nullptr && nextEvent < recording->events.size() && recording->events[nextEvent].step <= step)
+	{
+		const InputEvent& event = recording->events[nextEvent];
+		if (event.pressed == true)
+		{
+			game.userInput((sf::Keyboard::Key)event.key);
+		}
+		else
+		{
+			game.stopMovement((sf::Keyboard::Key)event.key);
+		}
+		nextEvent++;
+	}
+}
+
+//! Function to return whether the recording has run out.
+/*!
+\param uint32_t step - how many physics steps the game has taken.
+\return bool - true once every recorded step has been replayed.
+*/
+bool InputReplay::finished(uint32_t step) const
+{
+	return recording == nullptr || step >= recording->stepCount;
+}
@@ -1,6 +1,6 @@
 /*! \file item.cpp
 * \brief Contains function for creating an item object in the world.
-* As well as functions to check if object requires removal and how to do so.
+* As well as a function to take it out of the world once collected.
 */
 #include "item.h"
 
@@ -14,7 +14,7 @@
 \param uint16 maskBits -  - uint16 for physicalObject.h CollisionFilter enum, for what types object this will collide with.
 \param sf::Texture texture - an sfml reference to Texture to contain what texture this object should have.
 */
-Item::Item(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture)
+Item::Item(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture)
 {
 	//setting the texture for the object from the texture provided in the parameters.
 	setTexture(texture);
@@ -25,7 +25,6 @@ Item::Item(b2World* world, const sf::Vector2f position, const sf::Vector2f size,
 	bodyDef.angle = orientation * DEG2RAD;
 	//creating a body in the world and assigning the above attributes.
 	body = world->CreateBody(&bodyDef);
-	body->SetUserData(this);	//to be used by the contact listener.
 
 	//the shape element of the object, as it's a rectangle no radius.
 	b2PolygonShape shape;
@@ -55,10 +54,6 @@ Item::Item(b2World* world, const sf::Vector2f position, const sf::Vector2f size,
 
 	//initialising toRemove bool to false.
 	toRemove = false;
-
-	//initialising the object pool locations.
-	b_objectPool = b2Vec2(-10.0f, -10.0f);
-	sf_objectPool = sf::Vector2f(-10.0f, -10.0f);
 }
 
 //! Function to remove body, and therefore object, from world it is in.
@@ -71,25 +66,12 @@ Item::~Item()
 	//body->GetWorld()->DestroyBody(body);
 }
 
-//! Function to check all that needs to be checked each frame/step. For now it's only whether the object needs to be removed.
-/*!
-*/
-void Item::update()
-{
-	toBeRemovedCheck();
-}
-
-//! Function to to check whether toRemove bool is true and then deactive object and put back into its object pool location.
+//! Function to take the item out of the world, called by Game after the step it was collected in.
 /*!
 \param n/a
 */
-void Item::toBeRemovedCheck()
+void Item::despawn()
 {
-	//if objectContactListener sets toRemove to true, then deactive body and move to object pool.
-	if (toRemove == true)
-	{
-		body->SetActive(false);
-		body->SetTransform(b2Vec2(b_objectPool), 0.0f);
-		setPosition(sf_objectPool);
-	}
+	//bodies can't be changed during the step, so this waits until the contact listener has finished.
+	body->SetActive(false);
 }
\ No newline at end of file
@@ -0,0 +1,522 @@
+#include "level.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/*! \file level.cpp
+* \brief Contains functions to load a level from its text description, and to read and write the cooked binary form.
+* The text form is one object per line: "kind x y width height texture", plus "start x y", "end x" and "checkpoint x" lines.
+* Blank lines and lines starting with # are ignored.
+* The cooked form is a LevelHeader, then the checkpoint floats, then the chunk table, then the LevelEntity array sorted by chunk.
+* It is either read whole, or opened for streaming with each chunk's run of entities read when it is needed.
+*/
+
+//text names of each entity kind, in LevelEntity::Kind order.
+static const char* kindNames[LevelEntity::KIND_COUNT] = {
+	"player", "enemy", "coin", "obstacle", "ground", "platform", "sensor"
+};
+
+//text names of each texture, in LevelEntity::Texture order.
+static const char* textureNames[LevelEntity::TEXTURE_COUNT] = {
+	"none", "stones", "brick1x1", "brick2x1", "brick3x1", "brick4x1", "solidBlock", "coin", "smallTube", "bigTube", "flag", "goomba", "mario"
+};
+
+//! Function to return the text name of an entity kind.
+/*!
+\param int kind - one of LevelEntity::Kind.
+\return const char* - the name used in text level files.
+*/
+const char* LevelData::kindName(int kind)
+{
+	if (kind < 0 || kind >= LevelEntity::KIND_COUNT)
+	{
+		return "unknown";
+	}
+	return kindNames[kind];
+}
+
+//! Function to check that entities read from a cooked file are all of a known kind, as the kind indexes per kind tables.
+/*!
+\param LevelEntity entities - the first entity.
+\param size_t count - how many to check.
+\param bool players - true for the permanent entities, which must all be players, false for a chunk's, which must have none.
+\return bool - false if any kind is out of range or in the wrong place.
+*/
+bool LevelData::validKinds(const LevelEntity* entities, size_t count, bool players)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		//a player in a chunk would never be torn down with it.
+		if (entities[i].kind >= LevelEntity::KIND_COUNT || (entities[i].kind == LevelEntity::PLAYER) != players)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//! Function to check that a chunk table read from a cooked file splits the entities after the permanent ones into runs, in order with no gaps or overlaps.
+/*!
+\param std::vector chunks - the chunk table.
+\param uint32_t permanentCount - number of entities before the first chunk's.
+\param uint64_t entityCount - number of entities in the file.
+\return bool - false if any chunk's range is out of place, which would read past the entities or size collectedItems too small.
+*/
+bool LevelData::validChunks(const std::vector<LevelChunk>& chunks, uint32_t permanentCount, uint64_t entityCount)
+{
+	uint64_t next = permanentCount;
+	for (const LevelChunk& chunk : chunks)
+	{
+		if (chunk.firstEntity != next)
+		{
+			return false;
+		}
+		next += chunk.entityCount;
+	}
+	return next == entityCount;
+}
+
+//! Function to return the text name of a texture.
+/*!
+\param int texture - one of LevelEntity::Texture.
+\return const char* - the name used in text level files.
+*/
+const char* LevelData::textureName(int texture)
+{
+	if (texture < 0 || texture >= LevelEntity::TEXTURE_COUNT)
+	{
+		return "unknown";
+	}
+	return textureNames[texture];
+}
+
+//! Function to empty the level.
+/*!
+\param - n/a
+*/
+void LevelData::clear()
+{
+	startX = 0.0f;
+	startY = 0.0f;
+	endPosition = 0.0f;
+	checkpoints.clear();
+	entities.clear();
+	for (uint32_t& count : kindCounts)
+	{
+		count = 0;
+	}
+	chunkOrigin = 0.0f;
+	chunkWidth = 0.0f;
+	permanentCount = 0;
+	chunks.clear();
+	chunkFile.clear();
+	chunkFileOffset = 0;
+}
+
+//! Function to sort the entities into fixed width chunks along x and build the chunk table, players first as they are never streamed.
+/*!
+\param float width - width of each chunk.
+\ Each entity goes in the chunk its left edge is in, so a chunk's reach covers anything sticking out of its right side.
+*/
+void LevelData::buildChunks(float width)
+{
+	//the first chunk starts at the leftmost edge of anything streamed.
+	float origin = startX;
+	bool found = false;
+	for (const LevelEntity& entity : entities)
+	{
+		if (entity.kind != LevelEntity::PLAYER)
+		{
+			float left = entity.x - entity.width * 0.5f;
+			origin = found ? std::min(origin, left) : left;
+			found = true;
+		}
+	}
+
+	//find each entity's chunk, -1 for the permanent ones.
+	std::vector<int> chunkOf(entities.size());
+	int chunkCount = 0;
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		const LevelEntity& entity = entities[i];
+		chunkOf[i] = entity.kind == LevelEntity::PLAYER ? -1 : (int)std::floor((entity.x - entity.width * 0.5f - origin) / width);
+		chunkCount = std::max(chunkCount, chunkOf[i] + 1);
+	}
+
+	//sort by chunk, keeping the level's order within each so bodies are made in the same order as before.
+	std::vector<size_t> order(entities.size());
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return chunkOf[a] < chunkOf[b]; });
+	std::vector<LevelEntity> sorted;
+	sorted.reserve(entities.size());
+	for (size_t i : order)
+	{
+		sorted.push_back(entities[i]);
+	}
+	entities.swap(sorted);
+
+	//fill in the table, each chunk's run of entities and how far right it and those before it reach.
+	chunkOrigin = origin;
+	chunkWidth = width;
+	chunks.assign(chunkCount, LevelChunk{ 0, 0, origin });
+	float reach = origin;
+	size_t next = 0;
+	while (next < order.size() && chunkOf[order[next]] < 0)
+	{
+		next++;
+	}
+	permanentCount = (uint32_t)next;
+	for (int chunk = 0; chunk < chunkCount; chunk++)
+	{
+		chunks[chunk].firstEntity = (uint32_t)next;
+		while (next < order.size() && chunkOf[order[next]] == chunk)
+		{
+			reach = std::max(reach, entities[next].x + entities[next].width * 0.5f);
+			next++;
+		}
+		chunks[chunk].entityCount = (uint32_t)next - chunks[chunk].firstEntity;
+		chunks[chunk].reach = reach;
+	}
+}
+
+//! Function to return the first chunk that has an entity reaching x or further right, or any chunk before it does.
+/*!
+\param float x - the x co-ord.
+\return int - index of the chunk, or the chunk count if nothing reaches x.
+*/
+int LevelData::firstChunkReaching(float x) const
+{
+	//reach never decreases along the table, so this is a binary search.
+	auto chunk = std::partition_point(chunks.begin(), chunks.end(), [x](const LevelChunk& c) { return c.reach < x; });
+	return (int)(chunk - chunks.begin());
+}
+
+//! Function to return one past the last chunk whose left edge is at or left of x.
+/*!
+\param float x - the x co-ord.
+\return int - the index, between 0 and the chunk count.
+*/
+int LevelData::chunkEnd(float x) const
+{
+	if (chunks.empty())
+	{
+		return 0;
+	}
+	int end = (int)std::floor((x - chunkOrigin) / chunkWidth) + 1;
+	return std::min(std::max(end, 0), (int)chunks.size());
+}
+
+//! Function to add an object to the level, keeping the kind counts up to date.
+/*!
+\param LevelEntity entity - the object to add.
+*/
+void LevelData::addEntity(const LevelEntity& entity)
+{
+	entities.push_back(entity);
+	kindCounts[entity.kind]++;
+}
+
+//! Function to parse a text level description.
+/*!
+\param std::string fileName - path of the text level file.
+\return bool - whether the file was opened and every line parsed.
+*/
+bool LevelData::loadText(const std::string& fileName)
+{
+	std::ifstream file(fileName);
+	if (!file)
+	{
+		std::cout << "level " + fileName + " not found" << std::endl;
+		return false;
+	}
+
+	clear();
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+
+		//skip blank lines and comments.
+		std::istringstream stream(line);
+		std::string word;
+		if (!(stream >> word) || word[0] == '#')
+		{
+			continue;
+		}
+
+		//level wide values.
+		bool parsed = true;
+		if (word == "start")
+		{
+			parsed = (bool)(stream >> startX >> startY);
+		}
+		else if (word == "end")
+		{
+			parsed = (bool)(stream >> endPosition);
+		}
+		else if (word == "checkpoint")
+		{
+			float checkpoint;
+			parsed = (bool)(stream >> checkpoint);
+			checkpoints.push_back(checkpoint);
+		}
+		//otherwise it's an object, find which kind.
+		else
+		{
+			LevelEntity entity = {};
+			int kind = 0;
+			while (kind < LevelEntity::KIND_COUNT && word != kindNames[kind])
+			{
+				kind++;
+			}
+			if (kind == LevelEntity::KIND_COUNT)
+			{
+				std::cout << fileName << ":" << lineNumber << " unknown object '" << word << "'" << std::endl;
+				return false;
+			}
+			entity.kind = (uint8_t)kind;
+
+			parsed = (bool)(stream >> entity.x >> entity.y >> entity.width >> entity.height);
+
+			//texture name is optional, sensors don't have one.
+			std::string texture;
+			if (parsed && stream >> texture)
+			{
+				int id = 0;
+				while (id < LevelEntity::TEXTURE_COUNT && texture != textureNames[id])
+				{
+					id++;
+				}
+				if (id == LevelEntity::TEXTURE_COUNT)
+				{
+					std::cout << fileName << ":" << lineNumber << " unknown texture '" << texture << "'" << std::endl;
+					return false;
+				}
+				entity.texture = (uint8_t)id;
+			}
+			addEntity(entity);
+		}
+
+		if (parsed == false)
+		{
+			std::cout << fileName << ":" << lineNumber << " could not be parsed" << std::endl;
+			return false;
+		}
+	}
+
+	//the game starts by following the first player, so there has to be one.
+	if (kindCounts[LevelEntity::PLAYER] == 0)
+	{
+		std::cout << "level " + fileName + " has no player" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+//! Function to read a cooked binary level, everything but the chunks' entities as openCooked() does then those in one sequential read.
+/*!
+\param std::string fileName - path of the cooked level file.
+\return bool - whether the file was read and is a valid cooked level of a known version.
+*/
+bool LevelData::loadCooked(const std::string& fileName)
+{
+	if (!openCooked(fileName))
+	{
+		return false;
+	}
+	if (chunkFile.empty())
+	{
+		return true;
+	}
+
+	//the chunks follow the permanent entities, to the end of the file.
+	std::ifstream file(fileName, std::ios::binary);
+	uint32_t total = totalEntities();
+	entities.resize(total);
+	file.seekg((std::streamoff)(chunkFileOffset + permanentCount * sizeof(LevelEntity)), std::ios::beg);
+	if (!file.read((char*)(entities.data() + permanentCount), (total - permanentCount) * sizeof(LevelEntity)))
+	{
+		std::cout << "cooked level " + fileName + " could not be read" << std::endl;
+		return false;
+	}
+	if (!validKinds(entities.data() + permanentCount, total - permanentCount, false))
+	{
+		std::cout << "cooked level " + fileName + " is not a valid version " << cookedVersion << " level" << std::endl;
+		return false;
+	}
+	chunkFile.clear();
+	return true;
+}
+
+//! Function to read a cooked binary level for streaming, the header, checkpoints, chunk table and permanent entities but none of the chunks' entities.
+/*!
+\param std::string fileName - path of the cooked level file.
+\return bool - whether the file was read and is a valid cooked level of a known version.
+\ A version 1 level has no chunk table, so it is read whole and split into chunks in memory.
+*/
+bool LevelData::openCooked(const std::string& fileName)
+{
+	std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+	std::streamsize size = file.tellg();
+	file.seekg(0, std::ios::beg);
+
+	//check this is a cooked level of a known version.
+	LevelHeader header;
+	if (size < (std::streamsize)sizeof(LevelHeader) || !file.read((char*)&header, sizeof(header)))
+	{
+		std::cout << "cooked level " + fileName + " could not be read" << std::endl;
+		return false;
+	}
+	//the kind counts have to add up to the entities, they size the object lists, and there has to be a player to follow.
+	uint64_t countedEntities = 0;
+	for (int i = 0; i < LevelEntity::KIND_COUNT; i++)
+	{
+		countedEntities += header.kindCounts[i];
+	}
+	if (std::memcmp(header.magic, "CWLV", 4) != 0 || header.version < 1 || header.version > cookedVersion || header.checkpointCount > (uint64_t)size / sizeof(float) || countedEntities != header.entityCount || header.kindCounts[LevelEntity::PLAYER] == 0)
+	{
+		std::cout << "cooked level " + fileName + " is not a valid version " << cookedVersion << " level" << std::endl;
+		return false;
+	}
+
+	clear();
+	startX = header.startX;
+	startY = header.startY;
+	endPosition = header.endPosition;
+	for (int i = 0; i < LevelEntity::KIND_COUNT; i++)
+	{
+		kindCounts[i] = header.kindCounts[i];
+	}
+	checkpoints.resize(header.checkpointCount);
+	file.read((char*)checkpoints.data(), header.checkpointCount * sizeof(float));
+
+	//version 2 has the chunk table next.
+	LevelChunkTable table = {};
+	if (header.version >= 2)
+	{
+		file.read((char*)&table, sizeof(table));
+	}
+
+	//check the length before reading the rest, so a truncated or corrupt file is caught now rather than when a chunk is read.
+	size_t expected = sizeof(LevelHeader) + header.checkpointCount * sizeof(float) + header.entityCount * sizeof(LevelEntity);
+	if (header.version >= 2)
+	{
+		expected += sizeof(LevelChunkTable) + table.chunkCount * sizeof(LevelChunk);
+	}
+	if (!file || (size_t)size != expected || (header.version >= 2 && table.permanentCount != header.kindCounts[LevelEntity::PLAYER]))
+	{
+		std::cout << "cooked level " + fileName + " is not a valid version " << header.version << " level" << std::endl;
+		return false;
+	}
+	chunks.resize(table.chunkCount);
+	file.read((char*)chunks.data(), chunks.size() * sizeof(LevelChunk));
+	if (header.version >= 2 && (!file || !validChunks(chunks, table.permanentCount, header.entityCount) || (table.chunkCount > 0 && !(table.chunkWidth > 0.0f))))
+	{
+		std::cout << "cooked level " + fileName + " is not a valid version " << header.version << " level" << std::endl;
+		chunks.clear();
+		return false;
+	}
+
+	//version 1, read it all and split it here.
+	if (header.version == 1)
+	{
+		entities.resize(header.entityCount);
+		file.read((char*)entities.data(), header.entityCount * sizeof(LevelEntity));
+		if (!file)
+		{
+			std::cout << "cooked level " + fileName + " is not a valid version " << header.version << " level" << std::endl;
+			return false;
+		}
+		//splitting puts the players first, then the kinds and the player count can be checked as version 2's are.
+		buildChunks(defaultChunkWidth);
+		if (permanentCount != header.kindCounts[LevelEntity::PLAYER] || !validKinds(entities.data() + permanentCount, entities.size() - permanentCount, false))
+		{
+			std::cout << "cooked level " + fileName + " is not a valid version " << header.version << " level" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	//version 2, only the permanent entities, the rest stay in the file until their chunk is streamed in.
+	chunkOrigin = table.origin;
+	chunkWidth = table.chunkWidth;
+	permanentCount = table.permanentCount;
+	chunkFile = fileName;
+	chunkFileOffset = (uint64_t)file.tellg();
+	entities.resize(permanentCount);
+	file.read((char*)entities.data(), permanentCount * sizeof(LevelEntity));
+	if (!file || !validKinds(entities.data(), entities.size(), true))
+	{
+		std::cout << "cooked level " + fileName + " is not a valid version " << header.version << " level" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+//! Function to write this level as a cooked binary, split into chunks first if it hasn't been.
+/*!
+\param std::string fileName - path of the cooked level file to write.
+\return bool - whether the file was written.
+*/
+bool LevelData::saveCooked(const std::string& fileName) const
+{
+	//every entity has to be in memory to be written.
+	if (!chunkFile.empty())
+	{
+		std::cout << "cooked level " + fileName + " can't be written from a streamed level" << std::endl;
+		return false;
+	}
+	if (chunkWidth <= 0.0f)
+	{
+		LevelData chunked = *this;
+		chunked.buildChunks(defaultChunkWidth);
+		return chunked.saveCooked(fileName);
+	}
+
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		std::cout << "cooked level " + fileName + " could not be opened for writing" << std::endl;
+		return false;
+	}
+
+	//fill in the header.
+	LevelHeader header = {};
+	std::memcpy(header.magic, "CWLV", 4);
+	header.version = cookedVersion;
+	header.startX = startX;
+	header.startY = startY;
+	header.endPosition = endPosition;
+	header.checkpointCount = (uint32_t)checkpoints.size();
+	header.entityCount = (uint32_t)entities.size();
+	for (int i = 0; i < LevelEntity::KIND_COUNT; i++)
+	{
+		header.kindCounts[i] = kindCounts[i];
+	}
+
+	//and the chunk table.
+	LevelChunkTable table = {};
+	table.origin = chunkOrigin;
+	table.chunkWidth = chunkWidth;
+	table.permanentCount = permanentCount;
+	table.chunkCount = (uint32_t)chunks.size();
+
+	//write header, checkpoints, chunk table and entities back to back.
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)checkpoints.data(), checkpoints.size() * sizeof(float));
+	file.write((const char*)&table, sizeof(table));
+	file.write((const char*)chunks.data(), chunks.size() * sizeof(LevelChunk));
+	file.write((const char*)entities.data(), entities.size() * sizeof(LevelEntity));
+	return (bool)file;
+}
@@ -0,0 +1,341 @@
+#include "levelGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+/*! \file levelGenerator.cpp
+* \brief Contains functions to generate seeded levels and the canned stress scenes, with the measurements of world 1-1.
+* Ground blocks are 12 by 2 with their top at 3.29, objects stand on that top and the player starts at -3 as in world 1-1.
+*/
+
+//measurements shared with world 1-1.
+static const float groundY = 4.29f;
+static const float groundHeight = 2.0f;
+static const float groundTop = groundY - groundHeight * 0.5f;
+static const float gapWidth = 2.0f;
+static const float objectSize = 0.5f;
+
+//an area already taken on the current screen, so later objects can avoid it.
+struct TakenRect {
+	float x, y, width, height;
+
+	bool overlaps(float otherX, float otherY, float otherWidth, float otherHeight) const
+	{
+		return std::fabs(x - otherX) * 2.0f < width + otherWidth && std::fabs(y - otherY) * 2.0f < height + otherHeight;
+	}
+};
+
+//whether a rectangle overlaps anything taken.
+static bool isTaken(const std::vector<TakenRect>& taken, float x, float y, float width, float height)
+{
+	for (const TakenRect& rect : taken)
+	{
+		if (rect.overlaps(x, y, width, height))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//! Function to return a random float, made from the raw 32 bit output so it doesn't depend on the standard library's distributions.
+/*!
+\param float low - smallest value.
+\param float high - values are below this.
+\return float - the random value.
+*/
+float LevelGenerator::uniform(float low, float high)
+{
+	return low + (high - low) * (float)(random() / 4294967296.0);
+}
+
+//! Function to turn a density into a count, 2.3 gives 2 seven times in ten and 3 the other three.
+/*!
+\param float perScreen - the density.
+\return int - the count for this screen.
+*/
+int LevelGenerator::countFor(float perScreen)
+{
+	int whole = (int)perScreen;
+	return whole + (uniform(0.0f, 1.0f) < perScreen - whole ? 1 : 0);
+}
+
+//! Function to add an object to a level, unless its kind already holds as many as a BodyTag can index.
+/*!
+\param LevelData level - the level to add to.
+\param uint8_t kind - one of LevelEntity::Kind.
+\param uint8_t texture - one of LevelEntity::Texture.
+\param float x - x co-ord of the centre.
+\param float y - y co-ord of the centre.
+\param float width - width of the object.
+\param float height - height of the object.
+*/
+void LevelGenerator::add(LevelData& level, uint8_t kind, uint8_t texture, float x, float y, float width, float height)
+{
+	if (level.kindCounts[kind] >= maxPerKind)
+	{
+		return;
+	}
+	LevelEntity entity = { kind, texture, 0, x, y, width, height };
+	level.addEntity(entity);
+}
+
+//! Function to add the player, its respawn point and the listener's sensor, all where world 1-1 has them.
+/*!
+\param LevelData level - the level to add to.
+*/
+void LevelGenerator::addStart(LevelData& level)
+{
+	level.startX = -3.0f;
+	level.startY = 2.0f;
+	add(level, LevelEntity::SENSOR, LevelEntity::NO_TEXTURE, -3.0f, -3.0f, objectSize, objectSize);
+	add(level, LevelEntity::PLAYER, LevelEntity::MARIO, -3.0f, 3.0f, objectSize, objectSize);
+}
+
+//! Function to fill a level with a seeded layout of ground, gaps, tubes, platforms, coins and goombas.
+/*!
+\param GeneratorSettings settings - the seed, length and densities.
+\param LevelData level - emptied, then given the layout.
+*/
+void LevelGenerator::generate(const GeneratorSettings& settings, LevelData& level)
+{
+	level.clear();
+	random.seed(settings.seed);
+	addStart(level);
+
+	int screens = std::max(settings.screens, 1);
+	std::vector<TakenRect> taken;
+	for (int screen = 0; screen < screens; screen++)
+	{
+		float left = screen * (float)screenWidth - screenWidth * 0.5f;
+		//the first screen leaves room for the player to start, neither end has a gap.
+		float firstX = screen == 0 ? 0.0f : left + 1.0f;
+		bool gap = screen > 1 && screen < screens - 1 && uniform(0.0f, 1.0f) < settings.gapChance;
+		float groundWidth = gap ? screenWidth - gapWidth : (float)screenWidth;
+		float groundRight = left + groundWidth;
+		add(level, LevelEntity::GROUND, LevelEntity::STONES, left + groundWidth * 0.5f, groundY, groundWidth, groundHeight);
+		taken.clear();
+
+		//tubes on the ground, at least a tube's width apart so there is always somewhere to land between them.
+		int obstacles = countFor(settings.obstaclesPerScreen);
+		for (int i = 0; i < obstacles; i++)
+		{
+			bool big = uniform(0.0f, 1.0f) < 0.4f;
+			float height = big ? 1.8f : 1.0f;
+			float y = groundTop + 0.01f - height * 0.5f;
+			float x = uniform(firstX + 0.75f, groundRight - 0.75f);
+			if (!isTaken(taken, x, y, 1.5f * 3.0f, height))
+			{
+				add(level, LevelEntity::OBSTACLE, big ? LevelEntity::BIG_TUBE : LevelEntity::SMALL_TUBE, x, y, 1.5f, height);
+				taken.push_back({ x, y, 1.5f, height });
+			}
+		}
+
+		//brick platforms at the heights world 1-1 uses, they may hang over a gap.
+		int platforms = countFor(settings.platformsPerScreen);
+		for (int i = 0; i < platforms; i++)
+		{
+			bool wide = uniform(0.0f, 1.0f) < 0.5f;
+			float width = wide ? 2.0f : 1.5f;
+			float y = (float)(int)uniform(0.0f, 3.0f);
+			float x = uniform(firstX + width * 0.5f, left + screenWidth - width * 0.5f);
+			if (!isTaken(taken, x, y, width, objectSize + 1.0f))
+			{
+				add(level, LevelEntity::PLATFORM, wide ? LevelEntity::BRICK_4X1 : LevelEntity::BRICK_3X1, x, y, width, objectSize);
+				taken.push_back({ x, y, width, objectSize });
+			}
+		}
+
+		//goombas spread evenly along the ground with a little jitter, one landing on a tube stands on top of it.
+		int enemies = countFor(settings.enemiesPerScreen);
+		float spacing = (groundRight - 0.5f - firstX) / std::max(enemies, 1);
+		for (int i = 0; i < enemies; i++)
+		{
+			float x = firstX + (i + 0.5f) * spacing + uniform(-0.25f, 0.25f) * std::min(spacing, 1.0f);
+			float y = groundTop - objectSize * 0.5f - 0.04f;
+			for (const TakenRect& rect : taken)
+			{
+				if (rect.overlaps(x, y, objectSize, objectSize))
+				{
+					y = std::min(y, rect.y - (rect.height + objectSize) * 0.5f - 0.04f);
+				}
+			}
+			add(level, LevelEntity::ENEMY, LevelEntity::GOOMBA, x, y, objectSize, objectSize);
+		}
+
+		//coins in the air within jumping reach, clear of the tubes and platforms.
+		int coins = countFor(settings.coinsPerScreen);
+		for (int i = 0; i < coins; i++)
+		{
+			//a few tries each, so the coins asked for are nearly all placed.
+			for (int attempt = 0; attempt < 8; attempt++)
+			{
+				float x = uniform(left + 0.5f, left + screenWidth - 0.5f);
+				float y = uniform(-1.5f, 2.0f);
+				if (!isTaken(taken, x, y, objectSize, objectSize))
+				{
+					add(level, LevelEntity::COIN, LevelEntity::COIN_TEXTURE, x, y, objectSize, objectSize);
+					break;
+				}
+			}
+		}
+
+		//a checkpoint at the start of every other screen, where there is always ground.
+		if (screen > 0 && screen % 2 == 0)
+		{
+			level.checkpoints.push_back(left + 1.0f);
+		}
+	}
+	level.endPosition = (screens - 1) * (float)screenWidth;
+}
+
+//! Function to build a pit walled in by tall tubes just past the start, stacked full of goombas, all inside the wake distance.
+/*!
+\param int enemies - number of goombas.
+\param LevelData level - emptied, then given the scene.
+*/
+void LevelGenerator::pileUp(int enemies, LevelData& level)
+{
+	level.clear();
+	addStart(level);
+	for (int screen = 0; screen < 4; screen++)
+	{
+		add(level, LevelEntity::GROUND, LevelEntity::STONES, screen * (float)screenWidth, groundY, (float)screenWidth, groundHeight);
+	}
+
+	//goombas in a grid just clear of each other, as many rows as it takes.
+	const float pitLeft = -1.25f;
+	const float pitRight = 10.25f;
+	const float spacing = objectSize + 0.05f;
+	int columns = (int)((pitRight - pitLeft) / spacing);
+	int rows = (enemies + columns - 1) / columns;
+	for (int i = 0; i < enemies; i++)
+	{
+		float x = pitLeft + spacing * 0.5f + (i % columns) * spacing;
+		float y = groundTop - spacing * 0.5f - (i / columns) * spacing;
+		add(level, LevelEntity::ENEMY, LevelEntity::GOOMBA, x, y, objectSize, objectSize);
+	}
+
+	//walls taller than the stack.
+	float wallHeight = rows * spacing + 2.0f;
+	add(level, LevelEntity::OBSTACLE, LevelEntity::BIG_TUBE, pitLeft - 0.5f, groundTop - wallHeight * 0.5f, 1.0f, wallHeight);
+	add(level, LevelEntity::OBSTACLE, LevelEntity::BIG_TUBE, pitRight + 0.5f, groundTop - wallHeight * 0.5f, 1.0f, wallHeight);
+	level.endPosition = 3.0f * screenWidth;
+}
+
+//! Function to build a flat run covered in a carpet of coins ten rows deep, as long as the coins need.
+/*!
+\param int coins - number of coins.
+\param LevelData level - emptied, then given the scene.
+*/
+void LevelGenerator::coinCarpet(int coins, LevelData& level)
+{
+	level.clear();
+	addStart(level);
+
+	const int rows = 10;
+	const float spacing = objectSize;
+	int columns = (coins + rows - 1) / rows;
+	int screens = (int)std::ceil((columns * spacing + 6.0f) / screenWidth) + 1;
+	for (int screen = 0; screen < screens; screen++)
+	{
+		add(level, LevelEntity::GROUND, LevelEntity::STONES, screen * (float)screenWidth, groundY, (float)screenWidth, groundHeight);
+	}
+	for (int i = 0; i < coins; i++)
+	{
+		float x = (i / rows) * spacing;
+		float y = 2.5f - (i % rows) * spacing;
+		add(level, LevelEntity::COIN, LevelEntity::COIN_TEXTURE, x, y, objectSize, objectSize);
+	}
+	level.endPosition = (screens - 1) * (float)screenWidth;
+}
+
+//! Function to build a run of tubes packed close together, alternating small and big, with a goomba pacing between each pair.
+/*!
+\param int screens - length of the run in screens.
+\param LevelData level - emptied, then given the scene.
+*/
+void LevelGenerator::tubeForest(int screens, LevelData& level)
+{
+	level.clear();
+	addStart(level);
+
+	screens = std::max(screens, 1);
+	for (int screen = 0; screen < screens; screen++)
+	{
+		add(level, LevelEntity::GROUND, LevelEntity::STONES, screen * (float)screenWidth, groundY, (float)screenWidth, groundHeight);
+	}
+
+	const float pitch = 2.5f;
+	float end = (screens - 1) * (float)screenWidth;
+	int tube = 0;
+	for (float x = 1.0f; x < end; x += pitch, tube++)
+	{
+		bool big = tube % 2 == 1;
+		float height = big ? 1.8f : 1.0f;
+		add(level, LevelEntity::OBSTACLE, big ? LevelEntity::BIG_TUBE : LevelEntity::SMALL_TUBE, x, groundTop + 0.01f - height * 0.5f, 1.5f, height);
+		add(level, LevelEntity::ENEMY, LevelEntity::GOOMBA, x + pitch * 0.5f, groundTop - objectSize * 0.5f - 0.04f, objectSize, objectSize);
+	}
+	level.endPosition = end;
+}
+
+//! Function to build a level from a spec, "gen:seed:screens[:enemies[:coins]]" with totals for the whole level, or "scene:pileup|coincarpet|tubeforest[:count]".
+/*!
+\param std::string spec - the spec.
+\param LevelData level - given the level.
+\return bool - false if the spec isn't understood.
+*/
+bool LevelGenerator::fromSpec(const std::string& spec, LevelData& level)
+{
+	std::vector<std::string> parts;
+	std::stringstream stream(spec);
+	std::string part;
+	while (std::getline(stream, part, ':'))
+	{
+		parts.push_back(part);
+	}
+
+	if (parts.size() >= 3 && parts[0] == "gen")
+	{
+		GeneratorSettings settings;
+		settings.seed = (uint32_t)std::strtoul(parts[1].c_str(), nullptr, 10);
+		settings.screens = std::max(std::atoi(parts[2].c_str()), 1);
+		if (parts.size() >= 4)
+		{
+			settings.enemiesPerScreen = (float)std::atof(parts[3].c_str()) / settings.screens;
+		}
+		if (parts.size() >= 5)
+		{
+			settings.coinsPerScreen = (float)std::atof(parts[4].c_str()) / settings.screens;
+		}
+		LevelGenerator generator;
+		generator.generate(settings, level);
+		return true;
+	}
+
+	if (parts.size() >= 2 && parts[0] == "scene")
+	{
+		int count = parts.size() >= 3 ? std::atoi(parts[2].c_str()) : 0;
+		if (parts[1] == "pileup")
+		{
+			pileUp(count > 0 ? count : 1000, level);
+			return true;
+		}
+		if (parts[1] == "coincarpet")
+		{
+			coinCarpet(count > 0 ? count : 50000, level);
+			return true;
+		}
+		if (parts[1] == "tubeforest")
+		{
+			tubeForest(count > 0 ? count : 100, level);
+			return true;
+		}
+	}
+
+	std::cout << "level spec " + spec + " not understood, expected gen:seed:screens[:enemies[:coins]] or scene:pileup|coincarpet|tubeforest[:count]" << std::endl;
+	return false;
+}
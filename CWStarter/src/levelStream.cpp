@@ -0,0 +1,216 @@
+#include "levelStream.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include "tracer.h"
+
+/*! \file levelStream.cpp
+* \brief Contains functions to read a level's chunks on a stream thread, and to hand them to the game thread in the order it needs them.
+*/
+
+//! Function to stop the stream thread, and free whatever it read that was never taken.
+/*!
+\param - n/a
+*/
+LevelStream::~LevelStream()
+{
+	close();
+}
+
+//! Function to start streaming a level, opening its cooked file if it has one and starting the stream thread if threaded.
+/*!
+\param std::shared_ptr<const LevelData> streamed - the level, split into chunks.
+\param bool threaded - whether to read ahead on a thread, otherwise every chunk is read when it is taken.
+*/
+void LevelStream::open(std::shared_ptr<const LevelData> streamed, bool threaded)
+{
+	close();
+	level = streamed;
+	if (!level->chunkFile.empty())
+	{
+		gameFile.open(level->chunkFile, std::ios::binary);
+		if (threaded == true)
+		{
+			streamFile.open(level->chunkFile, std::ios::binary);
+		}
+	}
+	if (threaded == true)
+	{
+		running = true;
+		thread = std::thread(&LevelStream::run, this);
+	}
+}
+
+//! Function to stop the stream thread and drop every chunk asked for but not yet taken.
+/*!
+\param - n/a
+*/
+void LevelStream::close()
+{
+	if (thread.joinable())
+	{
+		running = false;
+		thread.join();
+	}
+	collect();
+	arrived.clear();
+	requested.clear();
+	int index;
+	while (requests.pop(index))
+	{
+	}
+	gameFile.close();
+	streamFile.close();
+}
+
+//! Function run by the stream thread, reading each chunk asked for and passing it back, sleeping briefly when there are none.
+/*!
+\param - n/a
+*/
+void LevelStream::run()
+{
+	while (running == true)
+	{
+		int index;
+		if (requests.pop(index))
+		{
+			TRACE_SCOPE("chunk", "stream");
+			Chunk* chunk = new Chunk();
+			read(streamFile, index, *chunk);
+			//no more than maxRequested are ever asked for, so there is always room.
+			results.push(chunk);
+		}
+		else
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+//! Function to read one chunk's entities, from the cooked file when streaming from one, otherwise from the level in memory.
+/*!
+\param std::ifstream file - the cooked file, one per thread reading from it.
+\param int index - which chunk.
+\param Chunk chunk - filled in with the chunk.
+\return bool - whether it was read, if not the chunk is left empty.
+*/
+bool LevelStream::read(std::ifstream& file, int index, Chunk& chunk) const
+{
+	const LevelChunk& table = level->chunks[index];
+	chunk.index = index;
+	chunk.entities.resize(table.entityCount);
+	if (level->chunkFile.empty())
+	{
+		std::copy(level->entities.begin() + table.firstEntity, level->entities.begin() + table.firstEntity + table.entityCount, chunk.entities.begin());
+		return true;
+	}
+
+	//each chunk is one contiguous read.
+	file.clear();
+	file.seekg((std::streamoff)(level->chunkFileOffset + table.firstEntity * sizeof(LevelEntity)), std::ios::beg);
+	if (!file.read((char*)chunk.entities.data(), table.entityCount * sizeof(LevelEntity)))
+	{
+		std::cout << "chunk " << index << " of " << level->chunkFile << " could not be read" << std::endl;
+		chunk.entities.clear();
+		return false;
+	}
+	//the kind indexes Game's per kind tables, and players are never streamed, so a corrupt one is never built.
+	if (!LevelData::validKinds(chunk.entities.data(), chunk.entities.size(), false))
+	{
+		std::cout << "cooked level " << level->chunkFile << " is not a valid version " << LevelData::cookedVersion << " level" << std::endl;
+		chunk.entities.clear();
+		return false;
+	}
+	return true;
+}
+
+//! Function to move every chunk the stream thread has read so far onto the arrived list.
+/*!
+\param - n/a
+*/
+void LevelStream::collect()
+{
+	Chunk* chunk;
+	while (results.pop(chunk))
+	{
+		arrived.push_back(std::unique_ptr<Chunk>(chunk));
+	}
+}
+
+//! Function to take a chunk off the requested list.
+/*!
+\param int index - which chunk.
+*/
+void LevelStream::unrequest(int index)
+{
+	requested.erase(std::remove(requested.begin(), requested.end(), index), requested.end());
+}
+
+//! Function to ask for a chunk to be read on the stream thread, ready for when it is taken.
+/*!
+\param int index - which chunk.
+\return bool - false if it wasn't asked for, when not threaded or already too many are waiting to be taken.
+*/
+bool LevelStream::prefetch(int index)
+{
+	if (!thread.joinable() || std::find(requested.begin(), requested.end(), index) != requested.end())
+	{
+		return false;
+	}
+	if (requested.size() >= maxRequested || !requests.push(index))
+	{
+		return false;
+	}
+	requested.push_back(index);
+	return true;
+}
+
+//! Function to return a chunk, straight away if it has been read, waiting for it if it is still being read, and otherwise reading it now.
+/*!
+\param int index - which chunk.
+\return std::unique_ptr<Chunk> - the chunk, its entities empty if it couldn't be read.
+*/
+std::unique_ptr<LevelStream::Chunk> LevelStream::take(int index)
+{
+	bool waiting = std::find(requested.begin(), requested.end(), index) != requested.end();
+	unrequest(index);
+	while (waiting == true)
+	{
+		collect();
+		for (size_t i = 0; i < arrived.size(); i++)
+		{
+			if (arrived[i]->index == index)
+			{
+				std::unique_ptr<Chunk> chunk = std::move(arrived[i]);
+				arrived.erase(arrived.begin() + i);
+				return chunk;
+			}
+		}
+		//it was asked for, so it is on its way.
+		std::this_thread::yield();
+	}
+
+	//never asked for, so read it here on the game thread.
+	TRACE_SCOPE("chunk", "stream");
+	std::unique_ptr<Chunk> chunk(new Chunk());
+	read(gameFile, index, *chunk);
+	return chunk;
+}
+
+//! Function to drop chunks read or asked for outside a range, after the camera has moved away from them.
+/*!
+\param int first - first chunk still wanted.
+\param int end - one past the last chunk still wanted.
+*/
+void LevelStream::forget(int first, int end)
+{
+	collect();
+	arrived.erase(std::remove_if(arrived.begin(), arrived.end(), [&](const std::unique_ptr<Chunk>& chunk) {
+		if (chunk->index >= first && chunk->index < end)
+		{
+			return false;
+		}
+		unrequest(chunk->index);
+		return true;
+	}), arrived.end());
+}
@@ -9,20 +9,77 @@
 
 #include <Box2D/Box2D.h>
 #include <SFML/Graphics.hpp>
+#include <cmath>
+#include <string>
 #include "game.h"
+#include "inputRecording.h"
+#include "tracer.h"
 
-void main() /** Entry point for the application */
+void main(int argc, char* argv[]) /** Entry point for the application, takes --level <file or spec>, --record <file>, --replay <file> or --trace <file> */
 {
 	sf::RenderWindow window(sf::VideoMode(800, 600), "1985 Super Mario Bros Clone"); // Open main window
+	//let display() wait on the monitor refresh, rather than spinning.
+	window.setVerticalSyncEnabled(true);
+
+	//input can be recorded to a file, or replayed from one in place of the keyboard.
+	InputRecording recording;
+	InputReplay replay;
+	std::string recordFile;
+	bool replaying = false;
+	//a trace can be captured from launch with --trace, or started and stopped with F2, and is written when it stops.
+	std::string traceFile = "trace.json";
+	//world 1-1 unless another level is given, a file or a generated level such as gen:7:1000:10000:50000 or scene:pileup.
+	std::string levelName;
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		std::string option = argv[i];
+		if (option == "--level")
+		{
+			levelName = argv[++i];
+		}
+		else if (option == "--record")
+		{
+			recordFile = argv[++i];
+		}
+		else if (option == "--replay" && recording.load(argv[++i]))
+		{
+			replay.start(&recording);
+			replaying = true;
+		}
+#ifdef TRACING
+		else if (option == "--trace")
+		{
+			traceFile = argv[++i];
+			Tracer::start();
+		}
+#endif
+	}
 
-	//reference to the game class.
-	Game game;
+	//a replay plays the level it was recorded on, unless told otherwise.
+	if (replaying == true && levelName.empty())
+	{
+		levelName = recording.levelName;
+	}
+
+	//reference to the game class, its assets and level load in the background while the first frames draw.
+	Game game(levelName);
+
+	//physics steps taken so far, what input is recorded and replayed against.
+	uint32_t step = 0;
+	//step the level was completed at, saved with the recording as part of its outcome.
+	int32_t completionStep = -1;
 
 	//make a lovely blue sky colour
 	sf::Color lovelyMarioBlue(107, 140, 255);
 
-	//setting the fps to 60 per second.
-	float frameTime = 1.0f / 60.f;
+	//setting the fixed physics step to 60 per second.
+	const float frameTime = 1.0f / 60.f;
+	//most physics steps caught up in one rendered frame, so a frame spike can't snowball.
+	const int maxSubSteps = 5;
+	//shortest time a rendered frame may take, sleeps out the rest if vsync isn't honoured by the driver.
+	const float minRenderTime = 1.0f / 144.f;
+	//time waiting to be consumed by fixed physics steps.
+	float accumulator = 0.0f;
 
 	// Start a clock to provide time for the physics
 	sf::Clock clock;
@@ -30,6 +87,9 @@ void main() /** Entry point for the application */
 	// Run a game loop
 	while (window.isOpen())
 	{
+		//the whole frame is a span in a trace, with the update stages and draw passes nested in it.
+		TRACE_SCOPE("frame", "frame");
+
 	   	sf::Event event;
 
 		while (window.pollEvent(event))
@@ -39,39 +99,118 @@ void main() /** Entry point for the application */
 			{
 				window.close();
 			}
+#ifdef TRACING
+			//F2 starts and stops a trace capture, even while replaying.
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F2)
+			{
+				if (Tracer::isCapturing() == true)
+				{
+					Tracer::stop(traceFile);
+				}
+				else
+				{
+					Tracer::start();
+				}
+				continue;
+			}
+#endif
+			//the keyboard is ignored while loading and while replaying.
+			if (game.isLoading() == true || replaying == true)
+			{
+				continue;
+			}
 			//event if key pressed, access the userInput() in game.cpp
 			if (event.type == sf::Event::KeyPressed)
 			{
 				game.userInput(event.key.code);
+				if (!recordFile.empty()) recording.record(step, event.key.code, true);
 			}
 			//event if key released, access the stopMovement() in game.cpp
 			else if (event.type == sf::Event::KeyReleased)
 			{
 				game.stopMovement(event.key.code);
+				if (!recordFile.empty()) recording.record(step, event.key.code, false);
 			}
 		}
 
-		// Find out how much time has elapsed
-		float elapsedTime = clock.getElapsedTime().asSeconds();
-
-		// If a frame has past the update the physics
-		if (elapsedTime > frameTime)
+		//while loading, finish a few more assets each frame and draw the loading bar.
+		//no time is banked meanwhile, so the level starts from its first step however long loading took.
+		if (game.isLoading() == true)
 		{
-			game.update(elapsedTime);
+			game.finishLoading();
 			clock.restart();
+			window.clear(lovelyMarioBlue);
+			window.draw(game);
+			window.display();
+			continue;
+		}
+
+		// Find out how much time has elapsed and bank it for the physics
+		accumulator += clock.restart().asSeconds();
+
+		// Update the physics in fixed steps, up to the cap
+		int subSteps = 0;
+		while (accumulator >= frameTime && subSteps < maxSubSteps)
+		{
+			if (replaying == true)
+			{
+				replay.feed(game, step);
+			}
+			game.update(frameTime);
+			step++;
+			if (completionStep < 0 && game.isLevelComplete() == true)
+			{
+				completionStep = (int32_t)step;
+			}
+			//once the recording runs out, the keyboard takes over again.
+			if (replaying == true && replay.finished(step))
+			{
+				replaying = false;
+			}
+			accumulator -= frameTime;
+			subSteps++;
+		}
+		// Still behind after the cap, drop the backlog rather than trying to catch up
+		if (accumulator >= frameTime)
+		{
+			accumulator = std::fmod(accumulator, frameTime);
 		}
 
+		// Draw the moving objects part way between the last two steps
+		game.interpolate(accumulator / frameTime);
+
 		//clear background to required colour.
 		window.clear(lovelyMarioBlue);
 		//draw the game.
 		window.draw(game);
-		//display to window the game.
+		//display to window the game, waits on vsync.
 		window.display();
-	}
-
-}
-
-
+		game.endFrame();
 
+		//if the frame still came in too quickly, sleep the rest of it off instead of spinning.
+		float renderTime = clock.getElapsedTime().asSeconds();
+		if (renderTime < minRenderTime)
+		{
+			sf::sleep(sf::seconds(minRenderTime - renderTime));
+		}
+	}
 
+	//save what was played, if asked to.
+	if (!recordFile.empty())
+	{
+		//with the level and how it ended, so the replay farm can check a replay comes out the same.
+		recording.stepCount = step;
+		recording.levelName = levelName;
+		recording.hasOutcome = true;
+		recording.outcome.score = game.getScore();
+		recording.outcome.lives = game.getLives();
+		recording.outcome.completionStep = completionStep;
+		recording.save(recordFile);
+	}
 
+	//write out a trace that is still capturing.
+	if (Tracer::isCapturing() == true)
+	{
+		Tracer::stop(traceFile);
+	}
+}
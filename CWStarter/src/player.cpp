@@ -17,7 +17,7 @@
 \param int frames - int for how many frames of animation are on the sprite sheet.
 \param float animDur - float for the time length required for each frame.
 */
-Player::Player(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture, sf::Sprite* sprite, int frames, float animDur)
+Player::Player(b2World* world, const sf::Vector2f position, const sf::Vector2f size, const float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture, sf::Sprite* sprite, int frames, float animDur)
 {
 	//setting the texture for the object from the texture provided in the parameters.
 	setTexture(texture);
@@ -37,7 +37,6 @@ Player::Player(b2World* world, const sf::Vector2f position, const sf::Vector2f s
 
 	//creating a body in the world and assigning the above attributes.
 	body = world->CreateBody(&bodyDef);
-	body->SetUserData(this);	//to be used by the contact listener.
 
 	//the shape element of the object, as it's a rectangle no radius.
 	b2PolygonShape shape;
@@ -71,16 +70,3 @@ Player::Player(b2World* world, const sf::Vector2f position, const sf::Vector2f s
 	setRotation(orientation);
 	setOutlineThickness(0.0f);
 }
-
-//! Function to update the position and rotation of this object within its world.
-/*!
-\param - n/a
-*/
-void Player::update()
-{
-	//updating the position and angle of this object.
-	b2Vec2 position = body->GetPosition();
-	setPosition(position.x, position.y);
-	float angle = body->GetAngle() * RAD2DEG;
-	setRotation(angle);
-}
@@ -0,0 +1,167 @@
+#include "profiler.h"
+#include <cstdio>
+#include <string>
+
+/*! \file profiler.cpp
+* \brief Contains functions to collect frame timings into the ring buffer and draw them as a stacked graph with a legend.
+*/
+
+//names of each stage for the legend, in ProfileStage order.
+static const char* stageNames[STAGE_COUNT] = {
+	"streaming", "activation", "step", "contacts", "player", "animation", "ui", "entities", "rules", "interpolate", "draw"
+};
+
+//! Function to return the name of a stage.
+/*!
+\param ProfileStage stage - the stage.
+\return const char* - its name, a string literal.
+*/
+const char* profileStageName(ProfileStage stage)
+{
+	return stageNames[stage];
+}
+
+//colour of each stage on the graph, in ProfileStage order.
+static const sf::Color stageColours[STAGE_COUNT] = {
+	sf::Color(150, 100, 60), sf::Color(120, 120, 120), sf::Color(230, 60, 60), sf::Color(240, 150, 40), sf::Color(240, 230, 60), sf::Color(140, 220, 60),
+	sf::Color(60, 200, 160), sf::Color(60, 160, 240), sf::Color(120, 90, 240), sf::Color(220, 90, 220), sf::Color(250, 250, 250)
+};
+
+//graph placement in UI co-ords, and how many pixels a millisecond is.
+static const float graphLeft = 20.0f;
+static const float graphBottom = 580.0f;
+static const float barWidth = 2.0f;
+static const float pixelsPerMs = 6.0f;
+
+//! Function to create the profiler with every frame zeroed.
+/*!
+\param - n/a
+*/
+FrameProfiler::FrameProfiler()
+{
+	for (ProfileFrame& frame : frames)
+	{
+		frame = {};
+	}
+	current = {};
+	graph.setPrimitiveType(sf::Quads);
+}
+
+//! Function to set the font for the legend.
+/*!
+\param sf::Font legendFont - the font, must outlive the profiler.
+*/
+void FrameProfiler::setFont(const sf::Font* legendFont)
+{
+	font = legendFont;
+	legend.setFont(*font);
+	legend.setCharacterSize(12);
+	legend.setPosition(graphLeft + frameHistory * barWidth + 20.0f, graphBottom - 190.0f);
+}
+
+//! Function to add the Box2D profile of one physics step to the current frame.
+/*!
+\param b2Profile profile - b2World::GetProfile() straight after a step.
+*/
+void FrameProfiler::addWorldProfile(const b2Profile& profile)
+{
+	current.collideMs += profile.collide;
+	current.solveMs += profile.solve;
+	current.broadphaseMs += profile.broadphase;
+}
+
+//! Function to finish the current frame into the ring buffer, overwriting the oldest, and start the next.
+/*!
+\param b2World world - the world, for its body and contact counts.
+*/
+void FrameProfiler::endFrame(const b2World* world)
+{
+	current.bodyCount = world->GetBodyCount();
+	current.contactCount = world->GetContactCount();
+
+	newestFrame = (newestFrame + 1) % frameHistory;
+	frames[newestFrame] = current;
+	current = {};
+}
+
+//! Function to return a finished frame.
+/*!
+\param int age - 0 for the newest frame, up to frameHistory - 1 for the oldest.
+\return ProfileFrame - the frame.
+*/
+const ProfileFrame& FrameProfiler::getFrame(int age) const
+{
+	return frames[(newestFrame - age + frameHistory) % frameHistory];
+}
+
+//! Function to draw one bar per frame with the stages stacked bottom to top, a 60 per second budget line, and a legend of averages.
+/*!
+\param sf::RenderTarget target - the target, with the UI view set.
+\param sf::RenderStates states - render states.
+*/
+void FrameProfiler::draw(sf::RenderTarget &target, sf::RenderStates states) const
+{
+	graph.clear();
+	float averages[STAGE_COUNT] = {};
+	for (int age = 0; age < frameHistory; age++)
+	{
+		//oldest on the left, newest on the right.
+		const ProfileFrame& frame = getFrame(age);
+		float left = graphLeft + (frameHistory - 1 - age) * barWidth;
+		float right = left + barWidth;
+		float bottom = graphBottom;
+		for (int stage = 0; stage < STAGE_COUNT; stage++)
+		{
+			float top = bottom - frame.stageMs[stage] * pixelsPerMs;
+			graph.append(sf::Vertex(sf::Vector2f(left, top), stageColours[stage]));
+			graph.append(sf::Vertex(sf::Vector2f(right, top), stageColours[stage]));
+			graph.append(sf::Vertex(sf::Vector2f(right, bottom), stageColours[stage]));
+			graph.append(sf::Vertex(sf::Vector2f(left, bottom), stageColours[stage]));
+			bottom = top;
+			averages[stage] += frame.stageMs[stage] / frameHistory;
+		}
+	}
+
+	//line across the graph at the 60 per second frame budget.
+	float budget = graphBottom - (1000.0f / 60.0f) * pixelsPerMs;
+	float graphRight = graphLeft + frameHistory * barWidth;
+	graph.append(sf::Vertex(sf::Vector2f(graphLeft, budget - 1.0f), sf::Color::Red));
+	graph.append(sf::Vertex(sf::Vector2f(graphRight, budget - 1.0f), sf::Color::Red));
+	graph.append(sf::Vertex(sf::Vector2f(graphRight, budget), sf::Color::Red));
+	graph.append(sf::Vertex(sf::Vector2f(graphLeft, budget), sf::Color::Red));
+
+	//a swatch of each stage's colour next to its legend line.
+	const float lineHeight = 14.0f;
+	sf::Vector2f legendPosition = legend.getPosition();
+	for (int stage = 0; stage < STAGE_COUNT; stage++)
+	{
+		float top = legendPosition.y + (STAGE_COUNT - 1 - stage) * lineHeight + 3.0f;
+		float left = legendPosition.x - 10.0f;
+		graph.append(sf::Vertex(sf::Vector2f(left, top), stageColours[stage]));
+		graph.append(sf::Vertex(sf::Vector2f(left + 8.0f, top), stageColours[stage]));
+		graph.append(sf::Vertex(sf::Vector2f(left + 8.0f, top + 8.0f), stageColours[stage]));
+		graph.append(sf::Vertex(sf::Vector2f(left, top + 8.0f), stageColours[stage]));
+	}
+	target.draw(graph, states);
+
+	if (font == nullptr)
+	{
+		return;
+	}
+
+	//stages listed top to bottom in the order they are stacked, bottom up, followed by the newest frame's Box2D breakdown.
+	std::string text;
+	char line[96];
+	for (int stage = STAGE_COUNT - 1; stage >= 0; stage--)
+	{
+		std::snprintf(line, sizeof(line), "%-12s %6.3f ms\n", stageNames[stage], averages[stage]);
+		text += line;
+	}
+	const ProfileFrame& newest = getFrame(0);
+	std::snprintf(line, sizeof(line), "collide %.2f solve %.2f\nbroadphase %.2f ms\n", newest.collideMs, newest.solveMs, newest.broadphaseMs);
+	text += line;
+	std::snprintf(line, sizeof(line), "bodies %d contacts %d", newest.bodyCount, newest.contactCount);
+	text += line;
+	legend.setString(text);
+	target.draw(legend, states);
+}
@@ -0,0 +1,142 @@
+#include "replayFarm.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <thread>
+#include "game.h"
+
+/*! \file replayFarm.cpp
+* \brief Contains functions to replay recordings headless, across every core, and compare how they end with how they were recorded to end.
+*/
+
+//! Function to build and step a tiny world with one contact, so Box2D fills in its shared tables here rather than racing to in the workers.
+/*!
+\param - n/a
+*/
+void ReplayFarm::warmUp()
+{
+	//b2BlockAllocator's size lookup and b2Contact's create/destroy registers are statics set up by whichever world first needs them.
+	b2World world(b2Vec2(0.0f, 9.81f));
+	b2BodyDef bodyDef;
+	b2PolygonShape shape;
+	shape.SetAsBox(0.5f, 0.5f);
+	world.CreateBody(&bodyDef)->CreateFixture(&shape, 1.0f);
+	bodyDef.type = b2_dynamicBody;
+	bodyDef.position.Set(0.0f, -0.9f);
+	world.CreateBody(&bodyDef)->CreateFixture(&shape, 1.0f);
+	world.Step(1.0f / 60.0f, 7, 5);
+}
+
+//! Function to replay a recording in a Game of its own, step for step as the windowed build played it, including steps after the game ended.
+/*!
+\param InputRecording recording - the recording.
+\return ReplayOutcome - the score and lives at the end, and the step the level was completed at.
+*/
+ReplayOutcome ReplayFarm::simulate(const InputRecording& recording)
+{
+	Game game(recording.levelName);
+	InputReplay replay;
+	replay.start(&recording);
+
+	//the same fixed step the windowed build runs at, 60 per second.
+	const float frameTime = 1.0f / 60.0f;
+	ReplayOutcome outcome;
+	for (uint32_t step = 0; step < recording.stepCount; step++)
+	{
+		replay.feed(game, step);
+		game.update(frameTime);
+		if (outcome.completionStep < 0 && game.isLevelComplete() == true)
+		{
+			outcome.completionStep = (int32_t)(step + 1);
+		}
+	}
+	outcome.score = game.getScore();
+	outcome.lives = game.getLives();
+	return outcome;
+}
+
+//! Function to list recordings, sorted so results come out in the same order each run.
+/*!
+\param std::string path - a directory to search (not recursively) for .cwin files, or a single recording.
+\return std::vector - the recordings found.
+*/
+std::vector<std::string> ReplayFarm::findRecordings(const std::string& path)
+{
+	std::vector<std::string> fileNames;
+	std::error_code error;
+	if (!std::filesystem::is_directory(path, error))
+	{
+		fileNames.push_back(path);
+		return fileNames;
+	}
+	for (const auto& entry : std::filesystem::directory_iterator(path, error))
+	{
+		if (entry.is_regular_file() && entry.path().extension() == ".cwin")
+		{
+			fileNames.push_back(entry.path().string());
+		}
+	}
+	std::sort(fileNames.begin(), fileNames.end());
+	return fileNames;
+}
+
+//! Function to replay every recording on a pool of threads, each worker taking the next recording until none are left.
+/*!
+\param std::vector fileNames - the recordings.
+\param unsigned threadCount - workers to use, 0 for one per core.
+\param bool bless - save each replay's outcome into its recording as the expected one, for after a deliberate change in behaviour.
+\return std::vector - one result per recording, in the same order.
+*/
+std::vector<ReplayResult> ReplayFarm::run(const std::vector<std::string>& fileNames, unsigned threadCount, bool bless)
+{
+	std::vector<ReplayResult> results(fileNames.size());
+	if (threadCount == 0)
+	{
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	threadCount = std::min(threadCount, (unsigned)std::max(fileNames.size(), (size_t)1));
+
+	warmUp();
+
+	//each worker writes only the results it claims, so nothing is shared but the counter.
+	std::atomic<size_t> next(0);
+	auto worker = [&]() {
+		for (size_t i = next++; i < fileNames.size(); i = next++)
+		{
+			ReplayResult& result = results[i];
+			result.fileName = fileNames[i];
+			InputRecording recording;
+			result.loaded = recording.load(fileNames[i]);
+			if (result.loaded == false)
+			{
+				continue;
+			}
+			result.hasExpected = recording.hasOutcome;
+			result.expected = recording.outcome;
+			result.steps = recording.stepCount;
+			result.actual = simulate(recording);
+
+			if (bless == true)
+			{
+				recording.hasOutcome = true;
+				recording.outcome = result.actual;
+				recording.save(fileNames[i]);
+				result.hasExpected = true;
+				result.expected = result.actual;
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (unsigned i = 1; i < threadCount; i++)
+	{
+		workers.emplace_back(worker);
+	}
+	//the calling thread works too.
+	worker();
+	for (std::thread& thread : workers)
+	{
+		thread.join();
+	}
+	return results;
+}
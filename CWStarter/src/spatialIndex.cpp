@@ -0,0 +1,100 @@
+#include "spatialIndex.h"
+#include <algorithm>
+#include <cmath>
+
+/*! \file spatialIndex.cpp
+* \brief Contains functions to build a 1D grid of the level's static objects and query it for an x range.
+* Cells are numbered along the whole of x and wrapped onto the grid, so only objects more than the grid's width apart share a cell.
+*/
+
+//! Function to empty the index and size its cells to span a range of x, beyond which they wrap around.
+/*!
+\param float left - left edge of the first cell.
+\param float right - right edge of the range, the level's or as much of it as is built at once.
+\param float width - width of each cell, around half the view width works well.
+*/
+void SpatialIndex::build(float left, float right, float width)
+{
+	minX = left;
+	cellWidth = width;
+	cells.clear();
+	cells.resize((size_t)std::max(1, (int)std::ceil((right - left) / width)));
+}
+
+//! Function to return the cell an x co-ord falls in, numbered along the whole of x, wrap() finds it in the grid.
+/*!
+\param float x - the x co-ord.
+\return int - number of the cell.
+*/
+int SpatialIndex::cellFor(float x) const
+{
+	return (int)std::floor((x - minX) / cellWidth);
+}
+
+//! Function to add an object to every cell its x range overlaps.
+/*!
+\param BodyTag tag - the object to add.
+\param float left - left edge of the object.
+\param float right - right edge of the object.
+*/
+void SpatialIndex::insert(BodyTag tag, float left, float right)
+{
+	//anything wider than the grid is in every cell once.
+	int first = cellFor(left);
+	int last = std::min(cellFor(right), first + (int)cells.size() - 1);
+	for (int cell = first; cell <= last; cell++)
+	{
+		wrap(cell).push_back({ tag, left, right, first });
+	}
+}
+
+//! Function to take an object out of every cell it was added to.
+/*!
+\param BodyTag tag - the object to remove.
+\param float left - left edge it was added with.
+\param float right - right edge it was added with.
+*/
+void SpatialIndex::remove(BodyTag tag, float left, float right)
+{
+	int first = cellFor(left);
+	int last = std::min(cellFor(right), first + (int)cells.size() - 1);
+	for (int cell = first; cell <= last; cell++)
+	{
+		std::vector<Entry>& entries = wrap(cell);
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			if (entries[i].tag.kind == tag.kind && entries[i].tag.index == tag.index)
+			{
+				//order within a cell doesn't matter, so swap the last entry into the gap.
+				entries[i] = entries.back();
+				entries.pop_back();
+				break;
+			}
+		}
+	}
+}
+
+//! Function to find every object overlapping an x range, each reported once.
+/*!
+\param float left - left edge of the range.
+\param float right - right edge of the range.
+\param std::vector<BodyTag> results - emptied, then filled with the objects found.
+*/
+void SpatialIndex::query(float left, float right, std::vector<BodyTag>& results) const
+{
+	results.clear();
+	int first = cellFor(left);
+	int last = cellFor(right);
+	for (int cell = first; cell <= last; cell++)
+	{
+		for (const Entry& entry : wrap(cell))
+		{
+			//an object spanning several cells is only reported from the first one the query covers.
+			//objects a grid's width away share the cell, but not the x range.
+			if (std::max(entry.firstCell, first) == cell && entry.right >= left && entry.left <= right)
+			{
+				results.push_back(entry.tag);
+			}
+		}
+	}
+}
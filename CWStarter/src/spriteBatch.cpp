@@ -0,0 +1,123 @@
+#include "spriteBatch.h"
+#include <cmath>
+
+/*! \file spriteBatch.cpp
+* \brief Contains functions to gather textured rectangles into per texture vertex arrays and draw them.
+*/
+
+//! Function to empty every batch ready for the next frame, the vertex arrays keep their memory.
+/*!
+\param - n/a
+*/
+void SpriteBatch::clear()
+{
+	for (size_t i = 0; i < usedBatches; i++)
+	{
+		batches[i].quads.clear();
+	}
+	usedBatches = 0;
+}
+
+//! Function to find the batch for a texture, or start a new one, reusing a spare batch from a previous frame if there is one.
+/*!
+\param sf::Texture texture - the texture to find the batch for.
+\return Batch - the batch that draws with this texture.
+*/
+SpriteBatch::Batch& SpriteBatch::batchFor(const sf::Texture* texture)
+{
+	//only a handful of textures, so a linear search is quickest.
+	for (size_t i = 0; i < usedBatches; i++)
+	{
+		if (batches[i].texture == texture)
+		{
+			return batches[i];
+		}
+	}
+
+	//not used yet this frame, take a spare batch or make a new one.
+	if (usedBatches == batches.size())
+	{
+		batches.push_back({ texture, sf::VertexArray(sf::Quads) });
+	}
+	Batch& batch = batches[usedBatches];
+	batch.texture = texture;
+	usedBatches++;
+	return batch;
+}
+
+//! Function to append one quad to a batch, from its corners in world co-ords.
+/*!
+\param Batch batch - the batch to add to.
+\param sf::Vector2f corners - top left, top right, bottom right and bottom left corners.
+\param sf::IntRect rect - the texture rect, a negative width or height flips the image.
+\param sf::Color colour - colour to tint the quad with.
+*/
+void SpriteBatch::addQuad(Batch& batch, const sf::Vector2f corners[4], const sf::IntRect& rect, const sf::Color& colour)
+{
+	float left = (float)rect.left;
+	float top = (float)rect.top;
+	float right = (float)(rect.left + rect.width);
+	float bottom = (float)(rect.top + rect.height);
+
+	batch.quads.append(sf::Vertex(corners[0], colour, sf::Vector2f(left, top)));
+	batch.quads.append(sf::Vertex(corners[1], colour, sf::Vector2f(right, top)));
+	batch.quads.append(sf::Vertex(corners[2], colour, sf::Vector2f(right, bottom)));
+	batch.quads.append(sf::Vertex(corners[3], colour, sf::Vector2f(left, bottom)));
+}
+
+//! Function to add a rectangle shape to the batch for its texture, as four transformed and textured vertices.
+/*!
+\param sf::RectangleShape shape - the shape to add, its position, rotation, size, texture rect and fill colour are used.
+*/
+void SpriteBatch::add(const sf::RectangleShape& shape)
+{
+	//corners of the shape in world co-ords.
+	const sf::Transform& transform = shape.getTransform();
+	sf::Vector2f size = shape.getSize();
+	const sf::Vector2f corners[4] = {
+		transform.transformPoint(0.0f, 0.0f),
+		transform.transformPoint(size.x, 0.0f),
+		transform.transformPoint(size.x, size.y),
+		transform.transformPoint(0.0f, size.y)
+	};
+
+	addQuad(batchFor(shape.getTexture()), corners, shape.getTextureRect(), shape.getFillColor());
+}
+
+//! Function to add an entry of a transform store, centred on its render position and rotated by its render angle.
+/*!
+\param sf::Texture texture - the texture its sprite rect is in.
+\param TransformStore store - the store holding the entry.
+\param size_t index - the entry to add.
+*/
+void SpriteBatch::add(const sf::Texture* texture, const TransformStore& store, size_t index)
+{
+	//half size along the rotated x and y axes, then the corners around the centre.
+	float cosine = std::cos(store.renderAngle[index]);
+	float sine = std::sin(store.renderAngle[index]);
+	sf::Vector2f xAxis(cosine * store.halfWidth[index], sine * store.halfWidth[index]);
+	sf::Vector2f yAxis(-sine * store.halfHeight[index], cosine * store.halfHeight[index]);
+	sf::Vector2f centre(store.renderX[index], store.renderY[index]);
+	const sf::Vector2f corners[4] = {
+		centre - xAxis - yAxis,
+		centre + xAxis - yAxis,
+		centre + xAxis + yAxis,
+		centre - xAxis + yAxis
+	};
+
+	addQuad(batchFor(texture), corners, store.spriteRects[index], sf::Color::White);
+}
+
+//! Function to draw each batch with its texture, one draw call per texture.
+/*!
+\param sf::RenderTarget target - the target to draw to.
+\param sf::RenderStates states - render states, the texture is set per batch.
+*/
+void SpriteBatch::draw(sf::RenderTarget &target, sf::RenderStates states) const
+{
+	for (size_t i = 0; i < usedBatches; i++)
+	{
+		states.texture = batches[i].texture;
+		target.draw(batches[i].quads, states);
+	}
+}
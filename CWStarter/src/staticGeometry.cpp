@@ -0,0 +1,277 @@
+#include "staticGeometry.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+/*! \file staticGeometry.cpp
+* \brief Contains functions to union a chunk's static blocks and build their outlines into chain loops on a single body.
+*/
+
+//! Function to add a block to be merged on the next build, snapping its edges to the grid.
+/*!
+\param BodyTag tag - the drawn object the block is, what contacts with its outline are tagged with.
+\param sf::FloatRect bounds - its bounds in the world.
+\param uint16 categoryBits - uint16 for physicalObject.h CollisionFilter enum, for what type object this is.
+\param uint16 maskBits - uint16 for physicalObject.h CollisionFilter enum, for what types object this will collide with.
+*/
+void StaticGeometry::add(BodyTag tag, const sf::FloatRect& bounds, uint16 categoryBits, uint16 maskBits)
+{
+	//blocks meant to touch snap to the same edge, so they merge exactly.
+	int left = (int)std::lround(bounds.left * snapPerMetre);
+	int top = (int)std::lround(bounds.top * snapPerMetre);
+	int right = (int)std::lround((bounds.left + bounds.width) * snapPerMetre);
+	int bottom = (int)std::lround((bounds.top + bounds.height) * snapPerMetre);
+	if (right <= left || bottom <= top)
+	{
+		std::cout << "block too thin to collide with, left out of the chunk's geometry" << std::endl;
+		return;
+	}
+	blocks.push_back({ tag, categoryBits, maskBits, sf::IntRect(left, top, right - left, bottom - top) });
+}
+
+//! Function to merge the blocks added into outlines, and create one static body with a chain loop per outline.
+/*!
+\param b2World world - the world to create the body in.
+\ Only blocks of the same kind and filter are merged, so ground, platforms and obstacles keep their own fixtures and filters.
+*/
+void StaticGeometry::build(b2World* world)
+{
+	if (blocks.empty())
+	{
+		return;
+	}
+
+	//sort so each kind and filter is one run, in order along x, its first block the one its outlines are tagged with.
+	auto sameGroup = [](const Block& a, const Block& b) {
+		return a.tag.kind == b.tag.kind && a.categoryBits == b.categoryBits && a.maskBits == b.maskBits;
+	};
+	std::sort(blocks.begin(), blocks.end(), [](const Block& a, const Block& b) {
+		if (a.tag.kind != b.tag.kind) return a.tag.kind < b.tag.kind;
+		if (a.categoryBits != b.categoryBits) return a.categoryBits < b.categoryBits;
+		if (a.maskBits != b.maskBits) return a.maskBits < b.maskBits;
+		if (a.rect.left != b.rect.left) return a.rect.left < b.rect.left;
+		return a.tag.index < b.tag.index;
+	});
+
+	//union blocks that overlap or touch, each set's root is its first block.
+	std::vector<size_t> parent(blocks.size());
+	std::iota(parent.begin(), parent.end(), 0);
+	auto find = [&](size_t i) {
+		while (parent[i] != i)
+		{
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+		return i;
+	};
+	for (size_t i = 0; i < blocks.size(); i++)
+	{
+		const sf::IntRect& a = blocks[i].rect;
+		//sorted by left, so once a block starts past this one's right no later one can touch it.
+		for (size_t j = i + 1; j < blocks.size() && sameGroup(blocks[i], blocks[j]) && blocks[j].rect.left <= a.left + a.width; j++)
+		{
+			const sf::IntRect& b = blocks[j].rect;
+			if (b.top <= a.top + a.height && a.top <= b.top + b.height)
+			{
+				size_t rootA = find(i);
+				size_t rootB = find(j);
+				parent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+			}
+		}
+	}
+
+	b2BodyDef bodyDef;
+	body = world->CreateBody(&bodyDef);
+
+	std::vector<sf::IntRect> rects;
+	std::vector<std::vector<sf::Vector2i>> loops;
+	std::vector<b2Vec2> vertices;
+	for (size_t first = 0; first < blocks.size(); first++)
+	{
+		if (find(first) != first)
+		{
+			continue;
+		}
+		rects.clear();
+		for (size_t i = first; i < blocks.size() && sameGroup(blocks[first], blocks[i]); i++)
+		{
+			if (find(i) == first)
+			{
+				rects.push_back(blocks[i].rect);
+			}
+		}
+
+		outline(rects, loops);
+		for (const std::vector<sf::Vector2i>& loop : loops)
+		{
+			vertices.clear();
+			for (const sf::Vector2i& vertex : loop)
+			{
+				vertices.push_back(b2Vec2((float)vertex.x / snapPerMetre, (float)vertex.y / snapPerMetre));
+			}
+			b2ChainShape shape;
+			shape.CreateLoop(vertices.data(), (int32)vertices.size());
+
+			//the same fixture settings as the StaticRects and Obstacles the blocks used to be.
+			b2FixtureDef fixtureDef;
+			fixtureDef.density = density;
+			fixtureDef.friction = friction;
+			fixtureDef.restitution = restitution;
+			fixtureDef.shape = &shape;
+			fixtureDef.filter.categoryBits = blocks[first].categoryBits;
+			fixtureDef.filter.maskBits = blocks[first].maskBits;
+			fixtureDef.userData = blocks[first].tag.toUserData();
+			body->CreateFixture(&fixtureDef);
+		}
+	}
+}
+
+//! Function to destroy the body, if built, and forget the blocks, ready to be used for another chunk.
+/*!
+\param b2World world - the world the body is in.
+*/
+void StaticGeometry::destroy(b2World* world)
+{
+	if (body != nullptr)
+	{
+		world->DestroyBody(body);
+		body = nullptr;
+	}
+	blocks.clear();
+}
+
+//! Function to trace the outlines of a union of rectangles, outer edges and the edges of any holes, as closed loops of corners.
+/*!
+\param std::vector rects - the rectangles, in integer units.
+\param std::vector loops - emptied, then given one loop per outline, the filled side always on the same side, with no two edges in a row along the same line.
+\ The rectangles' edges cut the plane into a grid of cells, the outline is every cell edge with a filled cell on one side only.
+\ Where two filled cells touch only at a corner the outline turns away from the other cell, so the two are never joined through that corner.
+*/
+void StaticGeometry::outline(const std::vector<sf::IntRect>& rects, std::vector<std::vector<sf::Vector2i>>& loops)
+{
+	loops.clear();
+	if (rects.empty())
+	{
+		return;
+	}
+
+	//the grid lines, every distinct edge.
+	std::vector<int> xs;
+	std::vector<int> ys;
+	for (const sf::IntRect& rect : rects)
+	{
+		xs.push_back(rect.left);
+		xs.push_back(rect.left + rect.width);
+		ys.push_back(rect.top);
+		ys.push_back(rect.top + rect.height);
+	}
+	std::sort(xs.begin(), xs.end());
+	xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+	std::sort(ys.begin(), ys.end());
+	ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+	int columns = (int)xs.size() - 1;
+	int rows = (int)ys.size() - 1;
+
+	//fill the cells each rectangle covers.
+	std::vector<char> filled(columns * rows, 0);
+	for (const sf::IntRect& rect : rects)
+	{
+		int firstColumn = (int)(std::lower_bound(xs.begin(), xs.end(), rect.left) - xs.begin());
+		int endColumn = (int)(std::lower_bound(xs.begin(), xs.end(), rect.left + rect.width) - xs.begin());
+		int firstRow = (int)(std::lower_bound(ys.begin(), ys.end(), rect.top) - ys.begin());
+		int endRow = (int)(std::lower_bound(ys.begin(), ys.end(), rect.top + rect.height) - ys.begin());
+		for (int row = firstRow; row < endRow; row++)
+		{
+			std::fill(filled.begin() + row * columns + firstColumn, filled.begin() + row * columns + endColumn, 1);
+		}
+	}
+	auto isFilled = [&](int column, int row) {
+		return column >= 0 && column < columns && row >= 0 && row < rows && filled[row * columns + column] != 0;
+	};
+
+	//boundary edges between grid points, each cell's going around it the same way: +x along its top, +y down its right, -x along its bottom, -y up its left.
+	struct Edge {
+		int from;	//!< grid point it starts at.
+		int to;		//!< grid point it ends at.
+		int dir;	//!< 0 +x, 1 +y, 2 -x, 3 -y.
+	};
+	std::vector<Edge> edges;
+	int pointColumns = columns + 1;
+	for (int row = 0; row < rows; row++)
+	{
+		for (int column = 0; column < columns; column++)
+		{
+			if (!isFilled(column, row))
+			{
+				continue;
+			}
+			int topLeft = row * pointColumns + column;
+			int topRight = topLeft + 1;
+			int bottomLeft = topLeft + pointColumns;
+			int bottomRight = bottomLeft + 1;
+			if (!isFilled(column, row - 1)) edges.push_back({ topLeft, topRight, 0 });
+			if (!isFilled(column + 1, row)) edges.push_back({ topRight, bottomRight, 1 });
+			if (!isFilled(column, row + 1)) edges.push_back({ bottomRight, bottomLeft, 2 });
+			if (!isFilled(column - 1, row)) edges.push_back({ bottomLeft, topLeft, 3 });
+		}
+	}
+
+	//the edges leaving each grid point, at most two where cells touch at a corner.
+	std::vector<int> firstOut(pointColumns * (rows + 1), -1);
+	std::vector<int> nextOut(edges.size(), -1);
+	for (int e = 0; e < (int)edges.size(); e++)
+	{
+		nextOut[e] = firstOut[edges[e].from];
+		firstOut[edges[e].from] = e;
+	}
+
+	std::vector<char> used(edges.size(), 0);
+	std::vector<int> loopEdges;
+	for (int start = 0; start < (int)edges.size(); start++)
+	{
+		if (used[start] != 0)
+		{
+			continue;
+		}
+
+		//follow the edges round, turning the way a single cell does where there is a choice, so cells touching at a corner aren't joined.
+		loopEdges.clear();
+		int e = start;
+		do
+		{
+			used[e] = 1;
+			loopEdges.push_back(e);
+			int next = -1;
+			int bestTurn = 4;
+			for (int out = firstOut[edges[e].to]; out != -1; out = nextOut[out])
+			{
+				//1 is the cell's own turn, then straight on, then the other way.
+				int turn = (edges[out].dir - edges[e].dir + 4) % 4;
+				int rank = turn == 1 ? 0 : (turn == 0 ? 1 : 2);
+				if (rank < bestTurn)
+				{
+					bestTurn = rank;
+					next = out;
+				}
+			}
+			e = next;
+		} while (e != start && e != -1);
+
+		//keep only the corners, where the direction changes.
+		std::vector<sf::Vector2i> loop;
+		size_t count = loopEdges.size();
+		for (size_t i = 0; i < count; i++)
+		{
+			const Edge& before = edges[loopEdges[(i + count - 1) % count]];
+			const Edge& edge = edges[loopEdges[i]];
+			if (before.dir != edge.dir)
+			{
+				loop.push_back(sf::Vector2i(xs[edge.from % pointColumns], ys[edge.from / pointColumns]));
+			}
+		}
+		if (loop.size() >= 3)
+		{
+			loops.push_back(std::move(loop));
+		}
+	}
+}
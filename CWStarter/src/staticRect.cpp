@@ -13,7 +13,7 @@
 \param uint16 maskBits -  - uint16 for physicalObject.h CollisionFilter enum, for what types object this will collide with.
 \param sf::Texture texture - an sfml reference to Texture to contain what texture this object should have.
 */
-StaticRect::StaticRect(b2World* world, const sf::Vector2f& position, const sf::Vector2f& size, const float orientation, uint16 categoryBits, uint16 maskBits, sf::Texture* texture)
+StaticRect::StaticRect(b2World* world, const sf::Vector2f& position, const sf::Vector2f& size, const float orientation, uint16 categoryBits, uint16 maskBits, const sf::Texture* texture)
 {
 	//setting the texture for the object from the texture provided in the parameters.
 	setTexture(texture);
@@ -24,7 +24,6 @@ StaticRect::StaticRect(b2World* world, const sf::Vector2f& position, const sf::V
 	bodyDef.angle = orientation * DEG2RAD;
 	//creating a body in the world and assigning the above attributes.
 	body = world->CreateBody(&bodyDef);
-	body->SetUserData(this);	//to be used by the contact listener.
 
 	//the shape element of the object, as it's a rectangle no radius.
 	b2PolygonShape shape;
@@ -51,4 +50,19 @@ StaticRect::StaticRect(b2World* world, const sf::Vector2f& position, const sf::V
 	setOrigin(size * 0.5f);
 	setRotation(orientation);
 	setOutlineThickness(0.0f);
-}
\ No newline at end of file
+}
+
+//! Function to create a static rectangle that is only drawn, with no body, its collision is part of its chunk's merged StaticGeometry.
+/*!
+\param sf::Vector2f position - a Vec2f of the desired position co-ords in world.
+\param sf::Vector2f size - a Vec2f of the desired size of object.
+\param sf::Texture texture - an sfml reference to Texture to contain what texture this object should have.
+*/
+StaticRect::StaticRect(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Texture* texture)
+{
+	setTexture(texture);
+	setPosition(position);
+	setSize(size);
+	setOrigin(size * 0.5f);
+	setOutlineThickness(0.0f);
+}
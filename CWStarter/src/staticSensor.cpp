@@ -20,7 +20,6 @@ StaticSensor::StaticSensor(b2World* world, const sf::Vector2f& position, const s
 	bodyDef.angle = orientation * DEG2RAD;
 	//creating the body and putting into the world.
 	body = world->CreateBody(&bodyDef);
-	body->SetUserData(this);	// used by our contact listener
 
 	//setting var for shape.
 	b2PolygonShape shape;
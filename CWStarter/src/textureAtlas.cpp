@@ -0,0 +1,253 @@
+#include "textureAtlas.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/*! \file textureAtlas.cpp
+* \brief Contains functions to pack textures into one atlas image, save it with its rect table, and load it back.
+* The table is one line "atlas image width height" naming the packed image, then one line "file left top width height" per texture.
+* Blank lines and lines starting with # are ignored.
+*/
+
+//! Function to load a packed atlas image and its table, decoding and uploading the image once.
+/*!
+\param std::string directory - directory holding the table and image, ending in a slash.
+\param std::string tableName - file name of the table.
+\return bool - whether the atlas was loaded.
+*/
+bool TextureAtlas::loadFromFile(const std::string& directory, const std::string& tableName)
+{
+	sf::Image image;
+	return decode(directory, tableName, image) && upload(image);
+}
+
+//! Function to read a packed atlas table and decode its image, without uploading it, so it can be done off the main thread.
+/*!
+\param std::string directory - directory holding the table and image, ending in a slash.
+\param std::string tableName - file name of the table.
+\param sf::Image image - image to decode the packed atlas into.
+\return bool - whether the table was read and the image decoded.
+*/
+bool TextureAtlas::decode(const std::string& directory, const std::string& tableName, sf::Image& image)
+{
+	std::ifstream file(directory + tableName);
+	if (!file)
+	{
+		return false;
+	}
+
+	rects.clear();
+	std::string imageName;
+	int width = 0;
+	int height = 0;
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+
+		//skip blank lines and comments.
+		std::istringstream stream(line);
+		std::string word;
+		if (!(stream >> word) || word[0] == '#')
+		{
+			continue;
+		}
+
+		bool parsed;
+		if (word == "atlas")
+		{
+			parsed = (bool)(stream >> imageName >> width >> height);
+		}
+		else
+		{
+			sf::IntRect rect;
+			parsed = (bool)(stream >> rect.left >> rect.top >> rect.width >> rect.height);
+			rects[word] = rect;
+		}
+
+		if (parsed == false)
+		{
+			std::cout << tableName << ":" << lineNumber << " could not be parsed" << std::endl;
+			return false;
+		}
+	}
+
+	//decode the packed image, checking it's the one the table was written for.
+	if (imageName.empty() || !image.loadFromFile(directory + imageName))
+	{
+		std::cout << "texture atlas " + imageName + " not loaded" << std::endl;
+		return false;
+	}
+	if ((int)image.getSize().x != width || (int)image.getSize().y != height)
+	{
+		std::cout << "texture atlas " + imageName + " does not match " + tableName << std::endl;
+		return false;
+	}
+	return true;
+}
+
+//! Function to pack separate textures into one image, on shelves from tallest to shortest.
+/*!
+\param std::string directory - directory holding the textures, ending in a slash.
+\param std::vector<std::string> fileNames - file names of the textures to pack.
+\param sf::Image image - image to pack the textures into.
+\param bool placeholders - pack a placeholder for any texture that won't load, rather than stopping.
+\return bool - whether every texture was loaded and packed, with placeholders the image is packed either way.
+*/
+bool TextureAtlas::pack(const std::string& directory, const std::vector<std::string>& fileNames, sf::Image& image, bool placeholders)
+{
+	//load every texture.
+	std::vector<sf::Image> images(fileNames.size());
+	unsigned int widest = 0;
+	bool loaded = true;
+	for (size_t i = 0; i < fileNames.size(); i++)
+	{
+		if (!images[i].loadFromFile(directory + fileNames[i]))
+		{
+			std::cout << "texture for " + fileNames[i] + " not loaded" << std::endl;
+			if (placeholders == false)
+			{
+				return false;
+			}
+			placeholder(images[i], placeholderSize, placeholderSize);
+			loaded = false;
+		}
+		widest = std::max(widest, images[i].getSize().x);
+	}
+
+	//place tallest first so each shelf wastes little height, ties by width then name so the layout is repeatable.
+	std::vector<size_t> order(fileNames.size());
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		if (images[a].getSize().y != images[b].getSize().y) return images[a].getSize().y > images[b].getSize().y;
+		if (images[a].getSize().x != images[b].getSize().x) return images[a].getSize().x > images[b].getSize().x;
+		return fileNames[a] < fileNames[b];
+	});
+
+	//atlas is as wide as the widest texture, rounded up to a power of two.
+	int width = 1;
+	while (width < (int)widest + padding * 2)
+	{
+		width *= 2;
+	}
+
+	//fill each shelf left to right, starting a new shelf under it when a texture won't fit.
+	rects.clear();
+	int x = padding;
+	int y = padding;
+	int shelfHeight = 0;
+	for (size_t i : order)
+	{
+		int w = (int)images[i].getSize().x;
+		int h = (int)images[i].getSize().y;
+		if (x + w + padding > width)
+		{
+			x = padding;
+			y += shelfHeight + padding;
+			shelfHeight = 0;
+		}
+		rects[fileNames[i]] = sf::IntRect(x, y, w, h);
+		x += w + padding;
+		shelfHeight = std::max(shelfHeight, h);
+	}
+	int height = y + shelfHeight + padding;
+
+	//copy each texture into its place.
+	image.create(width, height, sf::Color::Transparent);
+	for (size_t i = 0; i < fileNames.size(); i++)
+	{
+		const sf::IntRect& rect = rects[fileNames[i]];
+		image.copy(images[i], rect.left, rect.top);
+	}
+	return loaded;
+}
+
+//! Function to save a packed image and the table of where each texture is in it.
+/*!
+\param sf::Image image - the packed image.
+\param std::string directory - directory to save to, ending in a slash.
+\param std::string imageName - file name of the image.
+\param std::string tableName - file name of the table.
+\return bool - whether both files were written.
+*/
+bool TextureAtlas::saveToFile(const sf::Image& image, const std::string& directory, const std::string& imageName, const std::string& tableName) const
+{
+	if (!image.saveToFile(directory + imageName))
+	{
+		std::cout << "texture atlas " + imageName + " not saved" << std::endl;
+		return false;
+	}
+
+	std::ofstream file(directory + tableName);
+	if (!file)
+	{
+		std::cout << "texture atlas table " + tableName + " not saved" << std::endl;
+		return false;
+	}
+	file << "# texture atlas packed by CWAtlasPack, rebuild rather than edit." << std::endl;
+	file << "atlas " << imageName << " " << image.getSize().x << " " << image.getSize().y << std::endl;
+	for (const auto& entry : rects)
+	{
+		const sf::IntRect& rect = entry.second;
+		file << entry.first << " " << rect.left << " " << rect.top << " " << rect.width << " " << rect.height << std::endl;
+	}
+	return (bool)file;
+}
+
+//! Function to upload a packed image to the atlas texture.
+/*!
+\param sf::Image image - the packed image.
+\return bool - whether the upload worked.
+*/
+bool TextureAtlas::upload(const sf::Image& image)
+{
+	if (!texture.loadFromImage(image))
+	{
+		std::cout << "texture atlas not uploaded" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+//! Function to fill an image with a magenta and black checkerboard, drawn in place of a texture that is missing.
+/*!
+\param sf::Image image - image to fill.
+\param unsigned width - width of the image.
+\param unsigned height - height of the image.
+*/
+void TextureAtlas::placeholder(sf::Image& image, unsigned width, unsigned height)
+{
+	image.create(width, height, sf::Color::Black);
+	for (unsigned y = 0; y < height; y++)
+	{
+		for (unsigned x = 0; x < width; x++)
+		{
+			//checks 8 pixels across.
+			if (((x / 8) + (y / 8)) % 2 == 0)
+			{
+				image.setPixel(x, y, sf::Color::Magenta);
+			}
+		}
+	}
+}
+
+//! Function to return where a packed texture is in the atlas.
+/*!
+\param std::string fileName - file name the texture was packed from.
+\return sf::IntRect - its rect in the atlas, or an empty rect if it wasn't packed.
+*/
+sf::IntRect TextureAtlas::getRect(const std::string& fileName) const
+{
+	auto rect = rects.find(fileName);
+	if (rect == rects.end())
+	{
+		std::cout << "texture " + fileName + " not in atlas" << std::endl;
+		return sf::IntRect();
+	}
+	return rect->second;
+}
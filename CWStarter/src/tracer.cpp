@@ -0,0 +1,198 @@
+#include "tracer.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+/*! \file tracer.cpp
+* \brief Contains functions to record trace events into per thread buffers and write them as a Chrome trace-event JSON file.
+*/
+
+std::atomic<bool> Tracer::capturing(false);
+std::atomic<int64_t> Tracer::epochNs(0);
+size_t Tracer::capacity = Tracer::defaultCapacity;
+std::mutex Tracer::registryMutex;
+std::vector<TraceBuffer*> Tracer::buffers;
+
+//the calling thread's buffer, nullptr until it first records. buffers live until exit so stop() can always read them.
+static thread_local TraceBuffer* localBuffer = nullptr;
+
+//! Function to return the clock time, in nanoseconds from an arbitrary start.
+/*!
+\return int64_t - the current time.
+*/
+int64_t Tracer::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//! Function to clear every buffer and start recording, events are timed from here.
+/*!
+\param size_t eventsPerThread - events each thread's buffer holds before dropping.
+*/
+void Tracer::start(size_t eventsPerThread)
+{
+	//no thread may be writing a buffer while it is resized.
+	capturing.store(false);
+	std::lock_guard<std::mutex> lock(registryMutex);
+	waitForWriters();
+	capacity = eventsPerThread;
+	for (TraceBuffer* buffer : buffers)
+	{
+		buffer->events.resize(capacity);
+		buffer->count = 0;
+		buffer->dropped = 0;
+	}
+	epochNs.store(now());
+	capturing.store(true);
+}
+
+//! Function to return the calling thread's buffer, allocating it to capacity and registering it the first time.
+/*!
+\return TraceBuffer - the buffer.
+*/
+TraceBuffer& Tracer::threadBuffer()
+{
+	if (localBuffer == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+		localBuffer = new TraceBuffer();
+		localBuffer->events.resize(capacity);
+		localBuffer->threadId = (uint32_t)buffers.size() + 1;
+		buffers.push_back(localBuffer);
+	}
+	return *localBuffer;
+}
+
+//! Function to wait until no thread is inside record(), called with capturing already cleared and the registry locked.
+/*!
+\param - n/a
+\ A thread marks its buffer as writing before it checks capturing again, so once capturing is clear and writing is seen clear the buffer is left alone.
+*/
+void Tracer::waitForWriters()
+{
+	for (TraceBuffer* buffer : buffers)
+	{
+		while (buffer->writing.load() == true)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+//! Function to append an event to the calling thread's buffer, counting it as dropped when full.
+/*!
+\param TraceEvent event - the event.
+*/
+void Tracer::record(const TraceEvent& event)
+{
+	TraceBuffer& buffer = threadBuffer();
+	//mark the buffer as in use, then check the capture wasn't stopped in between, stop() waits for the mark to clear.
+	buffer.writing.store(true);
+	if (capturing.load() == false)
+	{
+		buffer.writing.store(false, std::memory_order_release);
+		return;
+	}
+	if (buffer.count < buffer.events.size())
+	{
+		buffer.events[buffer.count++] = event;
+	}
+	else
+	{
+		buffer.dropped++;
+	}
+	buffer.writing.store(false, std::memory_order_release);
+}
+
+//! Function to record a span that has finished.
+/*!
+\param const char* name - span name.
+\param const char* category - span category.
+\param int64_t startNs - clock time the span started, from now().
+\param int64_t endNs - clock time the span ended.
+*/
+void Tracer::complete(const char* name, const char* category, int64_t startNs, int64_t endNs)
+{
+	if (!isCapturing())
+	{
+		return;
+	}
+	int64_t epoch = epochNs.load(std::memory_order_relaxed);
+	record({ name, category, nullptr, startNs - epoch, endNs - startNs });
+}
+
+//! Function to record an instant event at the current time.
+/*!
+\param const char* name - event name.
+\param const char* category - event category.
+\param const char* detail - argument shown with the event, or nullptr.
+*/
+void Tracer::instant(const char* name, const char* category, const char* detail)
+{
+	if (!isCapturing())
+	{
+		return;
+	}
+	record({ name, category, detail, now() - epochNs.load(std::memory_order_relaxed), -1 });
+}
+
+//! Function to stop recording and write every thread's events to a JSON trace that chrome://tracing and Perfetto open.
+/*!
+\param std::string fileName - file to write.
+\return bool - whether the file was written.
+*/
+bool Tracer::stop(const std::string& fileName)
+{
+	capturing.store(false);
+
+	//a thread that saw capturing just before it cleared may still be writing its event.
+	std::lock_guard<std::mutex> lock(registryMutex);
+	waitForWriters();
+	std::ofstream file(fileName, std::ios::trunc);
+	if (!file)
+	{
+		std::cout << "trace " + fileName + " not saved" << std::endl;
+		return false;
+	}
+
+	//times are written in microseconds, the unit the format expects.
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool first = true;
+	char line[256];
+	size_t dropped = 0;
+	for (const TraceBuffer* buffer : buffers)
+	{
+		dropped += buffer->dropped;
+		for (size_t i = 0; i < buffer->count; i++)
+		{
+			const TraceEvent& event = buffer->events[i];
+			double ts = event.startNs / 1000.0;
+			if (event.durationNs >= 0)
+			{
+				std::snprintf(line, sizeof(line), "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u",
+					event.name, event.category, ts, event.durationNs / 1000.0, buffer->threadId);
+			}
+			else
+			{
+				std::snprintf(line, sizeof(line), "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u",
+					event.name, event.category, ts, buffer->threadId);
+			}
+			file << (first ? "" : ",\n") << line;
+			if (event.detail != nullptr)
+			{
+				file << ",\"args\":{\"detail\":\"" << event.detail << "\"}";
+			}
+			file << "}";
+			first = false;
+		}
+	}
+	file << "\n]}\n";
+
+	if (dropped > 0)
+	{
+		std::cout << "trace " + fileName + " dropped " << dropped << " events, the buffers were full" << std::endl;
+	}
+	return file.good();
+}
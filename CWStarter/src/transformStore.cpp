@@ -0,0 +1,156 @@
+#include "transformStore.h"
+
+/*! \file transformStore.cpp
+* \brief Contains functions to add moving objects to the transform store, and the passes that sync them from Box2D for rendering.
+* Each pass works on the range [first, last) of entries.
+*/
+
+//! Function to remove every entry.
+/*!
+\param - n/a
+*/
+void TransformStore::clear()
+{
+	bodies.clear();
+	previousX.clear();
+	previousY.clear();
+	previousAngle.clear();
+	currentX.clear();
+	currentY.clear();
+	currentAngle.clear();
+	renderX.clear();
+	renderY.clear();
+	renderAngle.clear();
+	halfWidth.clear();
+	halfHeight.clear();
+	spriteRects.clear();
+}
+
+//! Function to remove every entry from an index on, keeping those before it.
+/*!
+\param size_t count - how many entries to keep.
+*/
+void TransformStore::truncate(size_t count)
+{
+	bodies.resize(count);
+	previousX.resize(count);
+	previousY.resize(count);
+	previousAngle.resize(count);
+	currentX.resize(count);
+	currentY.resize(count);
+	currentAngle.resize(count);
+	renderX.resize(count);
+	renderY.resize(count);
+	renderAngle.resize(count);
+	halfWidth.resize(count);
+	halfHeight.resize(count);
+	spriteRects.resize(count);
+}
+
+//! Function to reserve room for a number of entries in every array.
+/*!
+\param size_t count - how many entries there will be.
+*/
+void TransformStore::reserve(size_t count)
+{
+	bodies.reserve(count);
+	previousX.reserve(count);
+	previousY.reserve(count);
+	previousAngle.reserve(count);
+	currentX.reserve(count);
+	currentY.reserve(count);
+	currentAngle.reserve(count);
+	renderX.reserve(count);
+	renderY.reserve(count);
+	renderAngle.reserve(count);
+	halfWidth.reserve(count);
+	halfHeight.reserve(count);
+	spriteRects.reserve(count);
+}
+
+//! Function to add an entry, starting all its transforms at the body's.
+/*!
+\param b2Body body - the body the entry follows.
+\param sf::Vector2f size - the drawn size.
+\param sf::IntRect spriteRect - rect of the atlas to draw with.
+\return size_t - index of the new entry.
+*/
+size_t TransformStore::add(b2Body* body, const sf::Vector2f& size, const sf::IntRect& spriteRect)
+{
+	bodies.push_back(body);
+	previousX.push_back(0.0f);
+	previousY.push_back(0.0f);
+	previousAngle.push_back(0.0f);
+	currentX.push_back(0.0f);
+	currentY.push_back(0.0f);
+	currentAngle.push_back(0.0f);
+	renderX.push_back(0.0f);
+	renderY.push_back(0.0f);
+	renderAngle.push_back(0.0f);
+	halfWidth.push_back(size.x * 0.5f);
+	halfHeight.push_back(size.y * 0.5f);
+	spriteRects.push_back(spriteRect);
+
+	size_t index = bodies.size() - 1;
+	snap(index);
+	return index;
+}
+
+//! Function to keep the current transforms as the previous ones, called before each physics step.
+/*!
+\param size_t first - first entry.
+\param size_t last - one past the last entry.
+*/
+void TransformStore::savePrevious(size_t first, size_t last)
+{
+	for (size_t i = first; i < last; i++)
+	{
+		previousX[i] = currentX[i];
+		previousY[i] = currentY[i];
+		previousAngle[i] = currentAngle[i];
+	}
+}
+
+//! Function to read each body's transform, called after each physics step. The only pass that follows the body pointers.
+/*!
+\param size_t first - first entry.
+\param size_t last - one past the last entry.
+*/
+void TransformStore::capture(size_t first, size_t last)
+{
+	for (size_t i = first; i < last; i++)
+	{
+		const b2Vec2& position = bodies[i]->GetPosition();
+		currentX[i] = position.x;
+		currentY[i] = position.y;
+		currentAngle[i] = bodies[i]->GetAngle();
+	}
+}
+
+//! Function to blend the render transforms between the last two physics steps, only plain float arrays so it vectorises.
+/*!
+\param size_t first - first entry.
+\param size_t last - one past the last entry.
+\param float alpha - how far between the previous and current physics step this frame is drawn, 0 to 1.
+*/
+void TransformStore::interpolate(size_t first, size_t last, float alpha)
+{
+	for (size_t i = first; i < last; i++)
+	{
+		renderX[i] = previousX[i] + (currentX[i] - previousX[i]) * alpha;
+		renderY[i] = previousY[i] + (currentY[i] - previousY[i]) * alpha;
+		renderAngle[i] = previousAngle[i] + (currentAngle[i] - previousAngle[i]) * alpha;
+	}
+}
+
+//! Function to jump an entry straight to its body's transform, so a teleport isn't interpolated across.
+/*!
+\param size_t index - the entry.
+*/
+void TransformStore::snap(size_t index)
+{
+	capture(index, index + 1);
+	previousX[index] = renderX[index] = currentX[index];
+	previousY[index] = renderY[index] = currentY[index];
+	previousAngle[index] = renderAngle[index] = currentAngle[index];
+}
@@ -0,0 +1,59 @@
+#pragma once
+/*!
+\file benchmark.h
+\brief Times benchmark bodies in repeated samples, reports ns/op with its spread, and saves or compares results as JSON.
+*/
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*! \struct BenchResult
+\brief The timings of one benchmark, all in nanoseconds per operation.
+*/
+
+struct BenchResult {
+	std::string name;		//!< benchmark name, what results are matched on when comparing.
+	double meanNs = 0.0;	//!< mean over the samples.
+	double stddevNs = 0.0;	//!< standard deviation over the samples.
+	double minNs = 0.0;		//!< fastest sample.
+	int samples = 0;		//!< samples taken.
+	int64_t opsPerSample = 0;	//!< operations timed in each sample.
+};
+
+/*! \class BenchRunner
+\brief Runs each benchmark body in samples long enough to time reliably, and keeps the results.
+\ A body is given how many operations to run and must do exactly that many, so the time per operation can be worked out.
+*/
+
+class BenchRunner {
+public:
+	typedef std::function<void(int64_t ops)> BenchBody;	//!< runs the given number of operations.
+private:
+	std::vector<BenchResult> results;	//!< results of every benchmark run so far.
+	std::string filter;					//!< only benchmarks whose name contains this are run.
+	int sampleCount = 15;				//!< timed samples per benchmark.
+	int64_t sampleTargetNs = 10000000;	//!< operations per sample are doubled until a sample takes at least this long.
+
+	static int64_t timeOps(const BenchBody& body, int64_t ops);	//!< function to time one sample of ops operations.
+public:
+	void setFilter(const std::string& nameFilter) { filter = nameFilter; }	//!< function to only run benchmarks whose name contains nameFilter.
+	void setSampleCount(int samples) { sampleCount = samples; }	//!< function to set the timed samples per benchmark.
+	bool wants(const std::string& name) const;	//!< function to return whether a benchmark passes the filter, so its setup can be skipped.
+
+	void run(const std::string& name, const BenchBody& body);	//!< function to calibrate, time and print one benchmark.
+	const std::vector<BenchResult>& getResults() const { return results; }	//!< function to return the results so far.
+
+	bool saveJson(const std::string& fileName) const;	//!< function to write the results as JSON.
+	static bool loadJson(const std::string& fileName, std::vector<BenchResult>& loaded);	//!< function to read results written by saveJson().
+	int compare(const std::vector<BenchResult>& baseline, double threshold) const;	//!< function to print the change from a baseline, returns the number of regressions.
+};
+
+//! keeps a result the optimiser would otherwise discard, so the work producing it is still timed.
+inline void keepAlive(size_t value)
+{
+	static volatile size_t sink;
+	sink = value;
+	//read it back, a volatile read can't be left out either.
+	(void)sink;
+}
@@ -0,0 +1,283 @@
+/*! \file benchMain.cpp
+\brief Contains the entry point for the microbenchmarks (CWStarterBench), timing the game's hot paths.
+* Run from the CWStarter directory, as the game is, so the cooked level loads.
+* The frame benchmarks play the generated stress levels from LevelGenerator.
+* Takes --filter <text>, --samples <n>, --json <file> to save the results and --compare <file> [--threshold <percent>] to check them against a saved baseline.
+*/
+
+#include <Box2D/Box2D.h>
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "benchmark.h"
+#include "game.h"
+
+/*! \struct BenchAccess
+\brief Game's friend, gives the benchmarks the parts of Game they time.
+*/
+
+struct BenchAccess {
+	static b2World* world(Game& game) { return game.world; }	//!< the game's world.
+	static ObjectContactListener& listener(Game& game) { return game.listener; }	//!< the listener set on the world.
+	static const SpatialIndex& staticIndex(Game& game) { return game.staticIndex; }	//!< the index the items are culled with.
+	static SFMLDebugDraw& debugDraw(Game& game) { return game.debugDraw; }	//!< the game's debug drawing.
+	static const sf::View& view(Game& game) { return game.view; }	//!< the camera's view of the world.
+	static void updateUI(Game& game) { game.updateUI(); }	//!< updates the score, time and lives text.
+	static void setScore(Game& game, int score) { game.score = score; }	//!< changes the score, so the next UI update has to rebuild its text.
+};
+
+/*! \class NullTarget
+\brief A render target that never activates, so drawing to it does all the CPU side work and then skips OpenGL.
+*/
+
+class NullTarget : public sf::RenderTarget {
+public:
+	NullTarget() { initialize(); }	//!< constructor, sets up the default view.
+	sf::Vector2u getSize() const { return sf::Vector2u(800, 600); }	//!< the same size as the game window.
+private:
+	bool activate(bool) { return false; }	//!< refuses, so no OpenGL call is ever made.
+};
+
+/*! \struct EnemyField
+\brief A floor with enemies spaced along it, all awake, for timing the step and enemy logic at different enemy counts.
+*/
+
+struct EnemyField {
+	std::unique_ptr<b2World> world;	//!< world of its own, separate from the game's.
+	sf::Sprite sprite;				//!< sprite the enemies are given, never drawn.
+	std::vector<Enemy> enemies;		//!< the enemies.
+
+	//! Function to build the floor and count enemies, then settle them for a second.
+	/*!
+	\param int count - number of enemies.
+	*/
+	EnemyField(int count) : world(new b2World(b2Vec2(0.0f, 9.81f)))
+	{
+		//one long static floor, a metre per enemy.
+		b2BodyDef floorDef;
+		floorDef.position.Set(count * 0.5f, 5.0f);
+		b2Body* floor = world->CreateBody(&floorDef);
+		b2PolygonShape floorShape;
+		floorShape.SetAsBox(count * 0.5f + 5.0f, 0.5f);
+		b2FixtureDef floorFixture;
+		floorFixture.shape = &floorShape;
+		floorFixture.filter.categoryBits = PhysicalObject::CollisionFilter::GROUND;
+		floor->CreateFixture(&floorFixture);
+
+		uint16 maskBits = PhysicalObject::CollisionFilter::GROUND | PhysicalObject::CollisionFilter::ENEMY;
+		enemies.reserve(count);
+		for (int i = 0; i < count; i++)
+		{
+			enemies.push_back(Enemy(world.get(), sf::Vector2f(i + 0.5f, 4.0f), sf::Vector2f(0.5f, 0.5f), 0.0f, PhysicalObject::CollisionFilter::ENEMY, maskBits, nullptr, &sprite, 2, 1.0f));
+			enemies.back().activate();
+		}
+		for (int i = 0; i < 60; i++)
+		{
+			step();
+		}
+	}
+
+	//! Function to run the enemies' logic then step the world, as Game::update does.
+	/*!
+	\param - n/a
+	*/
+	void step()
+	{
+		for (Enemy& enemy : enemies)
+		{
+			enemy.step();
+		}
+		world->Step(1.0f / 60.0f, 7, 5);
+	}
+};
+
+int main(int argc, char* argv[]) /** Entry point for the microbenchmarks */
+{
+	BenchRunner runner;
+	std::string jsonFile;
+	std::string baselineFile;
+	double threshold = 0.1;
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		std::string option = argv[i];
+		if (option == "--filter")
+		{
+			runner.setFilter(argv[++i]);
+		}
+		else if (option == "--samples")
+		{
+			runner.setSampleCount(std::atoi(argv[++i]));
+		}
+		else if (option == "--json")
+		{
+			jsonFile = argv[++i];
+		}
+		else if (option == "--compare")
+		{
+			baselineFile = argv[++i];
+		}
+		else if (option == "--threshold")
+		{
+			threshold = std::atof(argv[++i]) / 100.0;
+		}
+	}
+
+	//the level as the game loads it, played for two seconds with the player running right so there are live contacts.
+	Game game;
+	game.userInput(sf::Keyboard::Right);
+	for (int i = 0; i < 120; i++)
+	{
+		game.update(1.0f / 60.0f);
+	}
+
+	//contact dispatch, each op is one BeginContact and one EndContact on a contact taken from the level.
+	//handlers that count, like grounding, are left balanced by the pair, and the events they raise are drained as Game would.
+	if (runner.wants("contact/dispatch"))
+	{
+		std::vector<b2Contact*> contacts;
+		for (b2Contact* contact = BenchAccess::world(game)->GetContactList(); contact != nullptr; contact = contact->GetNext())
+		{
+			contacts.push_back(contact);
+		}
+		ObjectContactListener& listener = BenchAccess::listener(game);
+		GameEvent drained[16];
+		if (!contacts.empty())
+		{
+			runner.run("contact/dispatch", [&](int64_t ops) {
+				for (int64_t i = 0; i < ops; i++)
+				{
+					b2Contact* contact = contacts[i % contacts.size()];
+					listener.BeginContact(contact);
+					listener.EndContact(contact);
+					while (listener.getEvents().popBatch(drained, 16) > 0) {}
+				}
+			});
+		}
+	}
+
+	//world steps and the enemy logic, at increasing enemy counts. the step includes the enemies' logic, as in Game::update.
+	const int enemyCounts[] = { 10, 100, 1000, 10000 };
+	for (int count : enemyCounts)
+	{
+		std::string stepName = "step/enemies:" + std::to_string(count);
+		std::string logicName = "enemy/step:" + std::to_string(count);
+		if (!runner.wants(stepName) && !runner.wants(logicName))
+		{
+			continue;
+		}
+		EnemyField field(count);
+		runner.run(stepName, [&](int64_t ops) {
+			for (int64_t i = 0; i < ops; i++)
+			{
+				field.step();
+			}
+		});
+		//each op is one enemy's logic, the loop Game::update runs over the awake enemies.
+		runner.run(logicName, [&](int64_t ops) {
+			for (int64_t i = 0; i < ops; i++)
+			{
+				field.enemies[i % field.enemies.size()].step();
+			}
+		});
+	}
+
+	//items no longer have an update of their own, what runs for them each step is the cull of the static index to the view.
+	//each op is one query of a camera wide window, swept along the level.
+	{
+		const SpatialIndex& index = BenchAccess::staticIndex(game);
+		std::vector<BodyTag> visible;
+		runner.run("index/query", [&](int64_t ops) {
+			for (int64_t i = 0; i < ops; i++)
+			{
+				float left = (float)(i % 200) - 2.0f;
+				index.query(left, left + 16.0f, visible);
+				keepAlive(visible.size());
+			}
+		});
+	}
+
+	//the UI text, each op is one update of the score, time and lives text.
+	//steady is what most steps cost, nothing shown changes. changing has a new score each op, so the score text is rebuilt.
+	runner.run("ui/update:steady", [&](int64_t ops) {
+		for (int64_t i = 0; i < ops; i++)
+		{
+			BenchAccess::updateUI(game);
+		}
+	});
+	runner.run("ui/update:changing", [&](int64_t ops) {
+		for (int64_t i = 0; i < ops; i++)
+		{
+			BenchAccess::setScore(game, (int)(i % 100000));
+			BenchAccess::updateUI(game);
+		}
+	});
+
+	//debug draw shape collection, each op is collecting the shapes in the camera's view and handing them to a target that draws nothing.
+	//shapes is the default, all adds the AABB, contact, centre of mass and joint layers.
+	{
+		NullTarget target;
+		target.setView(BenchAccess::view(game));
+		SFMLDebugDraw& debugDraw = BenchAccess::debugDraw(game);
+		runner.run("debugdraw/collect:shapes", [&](int64_t ops) {
+			for (int64_t i = 0; i < ops; i++)
+			{
+				target.draw(debugDraw);
+			}
+		});
+		uint32 layers = b2Draw::e_aabbBit | b2Draw::e_pairBit | b2Draw::e_centerOfMassBit | b2Draw::e_jointBit;
+		debugDraw.toggleFlag(layers);
+		runner.run("debugdraw/collect:all", [&](int64_t ops) {
+			for (int64_t i = 0; i < ops; i++)
+			{
+				target.draw(debugDraw);
+			}
+		});
+		debugDraw.toggleFlag(layers);
+	}
+
+	//whole fixed steps of the generated stress levels, the standard inputs for per frame cost against entity count.
+	//each op is one Game::update with the player running right.
+	const char* levels[] = { "scene:pileup", "scene:coincarpet", "scene:tubeforest", "gen:1:1000:10000:50000" };
+	for (const char* levelName : levels)
+	{
+		std::string name = std::string("frame/") + levelName;
+		if (!runner.wants(name))
+		{
+			continue;
+		}
+		Game stressGame(levelName);
+		stressGame.userInput(sf::Keyboard::Right);
+		for (int i = 0; i < 60; i++)
+		{
+			stressGame.update(1.0f / 60.0f);
+		}
+		runner.run(name, [&](int64_t ops) {
+			for (int64_t i = 0; i < ops; i++)
+			{
+				stressGame.update(1.0f / 60.0f);
+			}
+		});
+	}
+
+	if (!jsonFile.empty())
+	{
+		runner.saveJson(jsonFile);
+	}
+
+	//a regression fails the run, so a script can stop on it.
+	if (!baselineFile.empty())
+	{
+		std::vector<BenchResult> baseline;
+		if (!BenchRunner::loadJson(baselineFile, baseline))
+		{
+			return 1;
+		}
+		int regressions = runner.compare(baseline, threshold);
+		std::cout << regressions << " regression(s)" << std::endl;
+		return regressions > 0 ? 1 : 0;
+	}
+	return 0;
+}
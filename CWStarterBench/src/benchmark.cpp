@@ -0,0 +1,205 @@
+#include "benchmark.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+/*! \file benchmark.cpp
+* \brief Contains functions to calibrate and time benchmarks, and to save, load and compare their results.
+*/
+
+//! Function to time a single sample.
+/*!
+\param BenchBody body - the benchmark body.
+\param int64_t ops - operations to run.
+\return int64_t - nanoseconds the sample took.
+*/
+int64_t BenchRunner::timeOps(const BenchBody& body, int64_t ops)
+{
+	auto start = std::chrono::steady_clock::now();
+	body(ops);
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+//! Function to check a benchmark name against the filter.
+/*!
+\param std::string name - benchmark name.
+\return bool - true if there is no filter or the name contains it.
+*/
+bool BenchRunner::wants(const std::string& name) const
+{
+	return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+//! Function to run a benchmark, doubling the operations per sample until a sample is long enough to time, then taking sampleCount samples.
+/*!
+\param std::string name - benchmark name, printed and saved with the result.
+\param BenchBody body - runs the number of operations it is given.
+*/
+void BenchRunner::run(const std::string& name, const BenchBody& body)
+{
+	if (!wants(name))
+	{
+		return;
+	}
+
+	//calibrate, which also warms the caches and whatever the body allocates.
+	int64_t ops = 1;
+	while (timeOps(body, ops) < sampleTargetNs && ops < (int64_t(1) << 40))
+	{
+		ops *= 2;
+	}
+
+	std::vector<double> perOp(sampleCount);
+	for (int i = 0; i < sampleCount; i++)
+	{
+		perOp[i] = (double)timeOps(body, ops) / ops;
+	}
+
+	BenchResult result;
+	result.name = name;
+	result.samples = sampleCount;
+	result.opsPerSample = ops;
+	result.minNs = perOp[0];
+	for (double ns : perOp)
+	{
+		result.meanNs += ns;
+		result.minNs = ns < result.minNs ? ns : result.minNs;
+	}
+	result.meanNs /= sampleCount;
+	for (double ns : perOp)
+	{
+		result.stddevNs += (ns - result.meanNs) * (ns - result.meanNs);
+	}
+	result.stddevNs = sampleCount > 1 ? std::sqrt(result.stddevNs / (sampleCount - 1)) : 0.0;
+	results.push_back(result);
+
+	char line[256];
+	std::snprintf(line, sizeof(line), "%-36s %14.1f ns/op  +/- %5.1f%%  min %14.1f  (%d x %lld ops)",
+		name.c_str(), result.meanNs, result.meanNs > 0.0 ? 100.0 * result.stddevNs / result.meanNs : 0.0, result.minNs, sampleCount, (long long)ops);
+	std::cout << line << std::endl;
+}
+
+//! Function to write the results, one benchmark to a line so baselines diff cleanly.
+/*!
+\param std::string fileName - file to write.
+\return bool - whether the file was written.
+*/
+bool BenchRunner::saveJson(const std::string& fileName) const
+{
+	std::ofstream file(fileName, std::ios::trunc);
+	if (!file)
+	{
+		std::cout << "results " + fileName + " not saved" << std::endl;
+		return false;
+	}
+
+	file << "{\"results\":[\n";
+	char line[512];
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const BenchResult& result = results[i];
+		std::snprintf(line, sizeof(line), "{\"name\":\"%s\",\"meanNs\":%.3f,\"stddevNs\":%.3f,\"minNs\":%.3f,\"samples\":%d,\"opsPerSample\":%lld}",
+			result.name.c_str(), result.meanNs, result.stddevNs, result.minNs, result.samples, (long long)result.opsPerSample);
+		file << line << (i + 1 < results.size() ? ",\n" : "\n");
+	}
+	file << "]}\n";
+	return file.good();
+}
+
+//find a number after "key": in a line written by saveJson, 0 if the key is missing.
+static double readNumber(const std::string& line, const char* key)
+{
+	size_t at = line.find(std::string("\"") + key + "\":");
+	if (at == std::string::npos)
+	{
+		return 0.0;
+	}
+	return std::strtod(line.c_str() + at + std::char_traits<char>::length(key) + 3, nullptr);
+}
+
+//! Function to read results written by saveJson(), only that layout is understood, not JSON in general.
+/*!
+\param std::string fileName - file to read.
+\param std::vector loaded - emptied, then given the results.
+\return bool - whether the file was read.
+*/
+bool BenchRunner::loadJson(const std::string& fileName, std::vector<BenchResult>& loaded)
+{
+	std::ifstream file(fileName);
+	if (!file)
+	{
+		std::cout << "results " + fileName + " not found" << std::endl;
+		return false;
+	}
+
+	loaded.clear();
+	std::string line;
+	while (std::getline(file, line))
+	{
+		size_t nameStart = line.find("\"name\":\"");
+		if (nameStart == std::string::npos)
+		{
+			continue;
+		}
+		nameStart += 8;
+		BenchResult result;
+		result.name = line.substr(nameStart, line.find('"', nameStart) - nameStart);
+		result.meanNs = readNumber(line, "meanNs");
+		result.stddevNs = readNumber(line, "stddevNs");
+		result.minNs = readNumber(line, "minNs");
+		result.samples = (int)readNumber(line, "samples");
+		result.opsPerSample = (int64_t)readNumber(line, "opsPerSample");
+		loaded.push_back(result);
+	}
+	return true;
+}
+
+//! Function to print each result's change from the baseline, flagging those slower by more than the threshold and more than the noise.
+/*!
+\param std::vector baseline - results loaded from a previous run.
+\param double threshold - fraction slower that counts as a regression, 0.1 for 10%.
+\return int - the number of regressions.
+*/
+int BenchRunner::compare(const std::vector<BenchResult>& baseline, double threshold) const
+{
+	int regressions = 0;
+	char line[256];
+	std::cout << std::endl << "compared with baseline:" << std::endl;
+	for (const BenchResult& result : results)
+	{
+		const BenchResult* before = nullptr;
+		for (const BenchResult& candidate : baseline)
+		{
+			if (candidate.name == result.name)
+			{
+				before = &candidate;
+				break;
+			}
+		}
+		if (before == nullptr || before->meanNs <= 0.0)
+		{
+			std::snprintf(line, sizeof(line), "%-36s   not in baseline", result.name.c_str());
+			std::cout << line << std::endl;
+			continue;
+		}
+
+		//a change within twice the combined spread of both runs is noise, whatever its size.
+		double change = (result.meanNs - before->meanNs) / before->meanNs;
+		double noise = 2.0 * std::sqrt(result.stddevNs * result.stddevNs + before->stddevNs * before->stddevNs);
+		bool regressed = change > threshold && result.meanNs - before->meanNs > noise;
+		bool improved = -change > threshold && before->meanNs - result.meanNs > noise;
+		if (regressed)
+		{
+			regressions++;
+		}
+
+		std::snprintf(line, sizeof(line), "%-36s %14.1f -> %14.1f ns/op  %+7.1f%%  %s",
+			result.name.c_str(), before->meanNs, result.meanNs, 100.0 * change, regressed ? "REGRESSION" : (improved ? "faster" : ""));
+		std::cout << line << std::endl;
+	}
+	return regressions;
+}
@@ -17,6 +17,8 @@ project "CWStarter"
 	targetdir ("bin/")
 	objdir ("build/")
 
+	--trace capture is compiled into every configuration, it costs one flag check per span until started.
+	defines "TRACING"
 	
 	files
 	{
@@ -24,6 +26,11 @@ project "CWStarter"
 		"%{prj.name}/**.cpp",
 	}
 
+	removefiles
+	{
+		"%{prj.name}/src/headlessMain.cpp"
+	}
+
 	includedirs
 	{
 		"%{prj.name}/include/",
@@ -39,7 +46,7 @@ project "CWStarter"
 	filter "configurations:Debug"
 		runtime "Debug"
 		symbols "On"
-			defines "SFML_STATIC"
+			defines { "SFML_STATIC", "PROFILING" }
 		
 		libdirs 
 		{
@@ -98,4 +105,278 @@ project "CWStarter"
 			"ogg.lib",
 			"jpeg.lib",
 			"freetype.lib"
-		}
\ No newline at end of file
+		}
+
+project "CWStarterHeadless"
+	location "CWStarter"
+	kind "ConsoleApp"
+	language "C++"
+	staticruntime "off"
+
+	targetdir ("bin/")
+	objdir ("build/headless/")
+
+	defines { "HEADLESS", "TRACING" }
+
+	files
+	{
+		"CWStarter/**.h",
+		"CWStarter/**.cpp",
+	}
+
+	removefiles
+	{
+		"CWStarter/src/main.cpp"
+	}
+
+	includedirs
+	{
+		"CWStarter/include/",
+		"../../vendor/Box2D/",
+		"../../vendor/SFML-2.4.2/include"
+	}
+
+	
+	filter "system:windows"
+		cppdialect "C++17"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "On"
+			defines { "SFML_STATIC", "PROFILING" }
+		
+		libdirs 
+		{
+			"../../vendor/Box2D/x64/Debug",
+			"../../vendor/SFML-2.4.2/lib"
+		}
+		
+		links
+		{
+			"Box2D",
+			"sfml-graphics-s-d",
+			"sfml-system-s-d",
+			"sfml-window-s-d",
+			"opengl32.lib",
+			"winmm.lib",
+			"gdi32.lib",
+			"jpeg.lib",
+			"freetype.lib"
+		}
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "On"
+		defines "SFML_STATIC"
+		
+		libdirs 
+		{
+			"../../vendor/Box2D/x64/Release",
+			"../../vendor/SFML-2.4.2/lib"
+		}
+		
+		links
+		{
+			"Box2D",
+			"sfml-graphics-s",
+			"sfml-system-s",
+			"sfml-window-s",
+			"opengl32.lib",
+			"winmm.lib",
+			"gdi32.lib",
+			"jpeg.lib",
+			"freetype.lib"
+		}
+
+project "CWStarterBench"
+	location "%{prj.name}"
+	kind "ConsoleApp"
+	language "C++"
+	staticruntime "off"
+
+	targetdir ("bin/")
+	objdir ("build/bench/")
+
+	--the game code is built headless, the benchmarks need no window or audio device. time the Release build.
+	defines "HEADLESS"
+
+	files
+	{
+		"%{prj.name}/**.h",
+		"%{prj.name}/**.cpp",
+		"CWStarter/**.h",
+		"CWStarter/**.cpp",
+	}
+
+	removefiles
+	{
+		"CWStarter/src/main.cpp",
+		"CWStarter/src/headlessMain.cpp"
+	}
+
+	includedirs
+	{
+		"%{prj.name}/include/",
+		"CWStarter/include/",
+		"../../vendor/Box2D/",
+		"../../vendor/SFML-2.4.2/include"
+	}
+
+	
+	filter "system:windows"
+		cppdialect "C++17"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "On"
+			defines "SFML_STATIC"
+		
+		libdirs 
+		{
+			"../../vendor/Box2D/x64/Debug",
+			"../../vendor/SFML-2.4.2/lib"
+		}
+		
+		links
+		{
+			"Box2D",
+			"sfml-graphics-s-d",
+			"sfml-system-s-d",
+			"sfml-window-s-d",
+			"opengl32.lib",
+			"winmm.lib",
+			"gdi32.lib",
+			"jpeg.lib",
+			"freetype.lib"
+		}
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "On"
+		defines "SFML_STATIC"
+		
+		libdirs 
+		{
+			"../../vendor/Box2D/x64/Release",
+			"../../vendor/SFML-2.4.2/lib"
+		}
+		
+		links
+		{
+			"Box2D",
+			"sfml-graphics-s",
+			"sfml-system-s",
+			"sfml-window-s",
+			"opengl32.lib",
+			"winmm.lib",
+			"gdi32.lib",
+			"jpeg.lib",
+			"freetype.lib"
+		}
+
+project "CWLevelCook"
+	location "%{prj.name}"
+	kind "ConsoleApp"
+	language "C++"
+	staticruntime "off"
+
+	targetdir ("bin/")
+	objdir ("build/levelcook/")
+
+	files
+	{
+		"%{prj.name}/**.cpp",
+		"CWStarter/include/level.h",
+		"CWStarter/src/level.cpp"
+	}
+
+	includedirs
+	{
+		"CWStarter/include/"
+	}
+
+	
+	filter "system:windows"
+		cppdialect "C++17"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "On"
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "On"
+
+project "CWAtlasPack"
+	location "%{prj.name}"
+	kind "ConsoleApp"
+	language "C++"
+	staticruntime "off"
+
+	targetdir ("bin/")
+	objdir ("build/atlaspack/")
+
+	files
+	{
+		"%{prj.name}/**.cpp",
+		"CWStarter/include/textureAtlas.h",
+		"CWStarter/src/textureAtlas.cpp"
+	}
+
+	includedirs
+	{
+		"CWStarter/include/",
+		"../../vendor/SFML-2.4.2/include"
+	}
+
+	
+	filter "system:windows"
+		cppdialect "C++17"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "On"
+		defines "SFML_STATIC"
+		
+		libdirs 
+		{
+			"../../vendor/SFML-2.4.2/lib"
+		}
+		
+		links
+		{
+			"sfml-graphics-s-d",
+			"sfml-window-s-d",
+			"sfml-system-s-d",
+			"opengl32.lib",
+			"winmm.lib",
+			"gdi32.lib",
+			"jpeg.lib",
+			"freetype.lib"
+		}
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "On"
+		defines "SFML_STATIC"
+		
+		libdirs 
+		{
+			"../../vendor/SFML-2.4.2/lib"
+		}
+		
+		links
+		{
+			"sfml-graphics-s",
+			"sfml-window-s",
+			"sfml-system-s",
+			"opengl32.lib",
+			"winmm.lib",
+			"gdi32.lib",
+			"jpeg.lib",
+			"freetype.lib"
+		}